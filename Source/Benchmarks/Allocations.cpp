@@ -0,0 +1,35 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "Benchmarks/Bench.h"
+
+/// Counts heap allocations made anywhere in the benchmark process, so benchmarks can report
+/// allocations per operation. Replaces the global allocation functions for AMMBenchmarks only.
+
+namespace {
+
+std::atomic<std::uint64_t> allocations(0);
+
+void* Allocate (std::size_t size) {
+   allocations.fetch_add(1, std::memory_order_relaxed);
+   if (void* p = std::malloc(size ? size : 1)) return p;
+   throw std::bad_alloc();
+}
+
+} // namespace
+
+namespace Bench {
+
+std::uint64_t AllocationCount () {
+   return allocations.load(std::memory_order_relaxed);
+}
+
+} // namespace Bench
+
+void* operator new (std::size_t size) { return Allocate(size); }
+void* operator new[] (std::size_t size) { return Allocate(size); }
+void operator delete (void* p) noexcept { std::free(p); }
+void operator delete[] (void* p) noexcept { std::free(p); }
+void operator delete (void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[] (void* p, std::size_t) noexcept { std::free(p); }
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#include "Metrics/Options.h"
+
+namespace Bench {
+
+/// Command line options in the form --key=value. Shared with AMMLoadGenerator.
+using Options = Metrics::Options;
+
+/// CPU time (user + system) consumed by this process so far, in seconds.
+inline double CpuSeconds () {
+#ifdef _WIN32
+   FILETIME creation, exit, kernel, user;
+   GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user);
+   auto toSeconds = [](const FILETIME& ft) {
+      ULARGE_INTEGER v;
+      v.LowPart = ft.dwLowDateTime;
+      v.HighPart = ft.dwHighDateTime;
+      return v.QuadPart * 1e-7;
+   };
+   return toSeconds(kernel) + toSeconds(user);
+#else
+   struct rusage usage;
+   getrusage(RUSAGE_SELF, &usage);
+   return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 1e-6
+        + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec * 1e-6;
+#endif
+}
+
+/// Wall clock seconds on a monotonic clock.
+inline double WallSeconds () {
+   using namespace std::chrono;
+   return duration_cast<duration<double>>(steady_clock::now().time_since_epoch()).count();
+}
+
+/// Resident memory of this process in bytes. Where the current size is not
+/// available (macOS) this is the peak, which still shows growth.
+inline std::uint64_t ResidentBytes () {
+#if defined(_WIN32)
+   PROCESS_MEMORY_COUNTERS counters;
+   GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+   return counters.WorkingSetSize;
+#elif defined(__linux__)
+   std::uint64_t size = 0, resident = 0;
+   std::ifstream statm("/proc/self/statm");
+   statm >> size >> resident;
+   return resident * static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+#else
+   struct rusage usage;
+   getrusage(RUSAGE_SELF, &usage);
+   return static_cast<std::uint64_t>(usage.ru_maxrss);
+#endif
+}
+
+/// Number of threads in this process, or 0 where that is not available.
+inline int ThreadCount () {
+#if defined(__linux__)
+   std::ifstream status("/proc/self/status");
+   std::string key;
+   while (status >> key) {
+      if (key == "Threads:") {
+         int threads = 0;
+         status >> threads;
+         return threads;
+      }
+   }
+   return 0;
+#else
+   return 0;
+#endif
+}
+
+/// Heap allocations made by this process so far. See Allocations.cpp.
+std::uint64_t AllocationCount ();
+
+/// A std::chrono duration in microseconds.
+template <typename Duration>
+inline double Micros (Duration d) {
+   return std::chrono::duration<double, std::micro>(d).count();
+}
+
+} // namespace Bench
@@ -0,0 +1,87 @@
+#include <iostream>
+#include <string>
+
+#include "Benchmarks/Bench.h"
+
+namespace Bench { int RunLoopIdle (const Options& opts); }
+namespace Bench { int Startup (const Options& opts); }
+namespace Bench { int Handoff (const Options& opts); }
+namespace Bench { int SimState (const Options& opts); }
+namespace Bench { int Reset (const Options& opts); }
+namespace Bench { int SaveState (const Options& opts); }
+namespace Bench { int ParticipantCycle (const Options& opts); }
+namespace Bench { int Topics (const Options& opts); }
+namespace Bench { int Logging (const Options& opts); }
+namespace Bench { int ValueCache (const Options& opts); }
+namespace Bench { int Waveform (const Options& opts); }
+namespace Bench { int Priority (const Options& opts); }
+namespace Bench { int WriteErrors (const Options& opts); }
+namespace Bench { int ModuleHost (const Options& opts); }
+namespace Bench { int Dispatch (const Options& opts); }
+namespace Bench { int WorkerPool (const Options& opts); }
+namespace Bench { int Inbox (const Options& opts); }
+namespace Bench { int Uuid (const Options& opts); }
+
+/// AMM example module benchmarks.
+///
+/// Usage: AMMBenchmarks <benchmark> [--key=value ...]
+int main (int argc, char* argv[]) {
+
+   if (argc < 2) {
+      std::cout
+      << " Usage: AMMBenchmarks <benchmark> [--key=value ...]\n"
+      << "\n"
+      << " run_loop_idle    Idle CPU of the module run loop (--duration, --timer-hz, --spin)\n"
+      << " startup          Time to first received Operational Description (--mode=sleep|gate)\n"
+      << " handoff          Listener-to-module handoff queue (--policy=drop|block|post, --rate, --work-us)\n"
+      << " sim_state        RUN/HALT transition-to-effect latency and state reads (--tick-hz, --mutex)\n"
+      << " reset            Cost of RESET for deep copied vs versioned state (--mode=deep|versioned)\n"
+      << " save_state       Binary save state write and restore vs reading the XML config (--pad-bytes)\n"
+      << " participant_cycle  Create, publish, tear down x1000: time and memory (--mode=session|recreate)\n"
+      << " topics           Per-type latency, throughput and CPU for all AMM types (--types, --payloads, --transport)\n"
+      << " logging          Per-call cost of callback logging (--mode=cout|async, --threads, --file)\n"
+      << " value_cache      Physiology Value cache update rate and lookup latency (--mode=cache|map, --writers)\n"
+      << " waveform         Chunked vs per-point waveform publishing (--mode=chunked|point, --rate, --chunk)\n"
+      << " priority         Simulation Control latency under bulk load (--lanes=on|off, --bulk-rate, --work-us)\n"
+      << " write_errors     Allocations per successful write: errmsg vs error codes (--mode=errmsg|code)\n"
+      << " module_host      Participants, threads and memory for N logical modules (--modules, --mode=host|separate)\n"
+      << " dispatch         Subscriber callback cost: function pointer vs Module::Dispatcher (--handlers)\n"
+      << " worker_pool      Callback worker pool scaling and per-topic order (--threads=1,2,4, --topics)\n"
+      << " inbox            Sequential module logic vs callbacks, per sample (--mode=inbox|callback, --rate)\n"
+      << " uuid             UUID parse, compare and lookup: text vs binary (--ids, --count)\n";
+      return 1;
+   }
+
+   Bench::Options opts;
+   for (int i = 2; i < argc; ++i) {
+      std::string arg = argv[i];
+      if (arg.compare(0, 2, "--") != 0) continue;
+      auto eq = arg.find('=');
+      if (eq == std::string::npos) opts.values[arg.substr(2)] = "";
+      else opts.values[arg.substr(2, eq - 2)] = arg.substr(eq + 1);
+   }
+
+   std::string name = argv[1];
+
+   if      (name == "run_loop_idle") return Bench::RunLoopIdle(opts);
+   else if (name == "startup")       return Bench::Startup(opts);
+   else if (name == "handoff")       return Bench::Handoff(opts);
+   else if (name == "sim_state")     return Bench::SimState(opts);
+   else if (name == "reset")         return Bench::Reset(opts);
+   else if (name == "save_state")    return Bench::SaveState(opts);
+   else if (name == "participant_cycle") return Bench::ParticipantCycle(opts);
+   else if (name == "topics")        return Bench::Topics(opts);
+   else if (name == "logging")       return Bench::Logging(opts);
+   else if (name == "value_cache")   return Bench::ValueCache(opts);
+   else if (name == "waveform")      return Bench::Waveform(opts);
+   else if (name == "priority")      return Bench::Priority(opts);
+   else if (name == "write_errors")  return Bench::WriteErrors(opts);
+   else if (name == "module_host")   return Bench::ModuleHost(opts);
+   else if (name == "dispatch")      return Bench::Dispatch(opts);
+   else if (name == "worker_pool")   return Bench::WorkerPool(opts);
+   else if (name == "inbox")         return Bench::Inbox(opts);
+   else if (name == "uuid")          return Bench::Uuid(opts);
+
+   std::cout << "Unknown benchmark: " << name << std::endl;
+   return 1;
+}
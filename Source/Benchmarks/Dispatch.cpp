@@ -0,0 +1,112 @@
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <amm_std.h>
+
+#include "Benchmarks/Bench.h"
+#include "Metrics/Report.h"
+#include "Module/Dispatcher.h"
+
+namespace Bench {
+
+namespace {
+
+using Callback = void (*) (AMM::Tick&, eprosima::fastrtps::SampleInfo_t*);
+
+long long ticksSeen = 0;
+
+void OnTick (AMM::Tick& tick, eprosima::fastrtps::SampleInfo_t* info) {
+   ticksSeen += tick.frame();
+}
+
+struct Receiver {
+   long long seen = 0;
+   void OnTick (AMM::Tick& tick) { seen += tick.frame(); }
+};
+
+/// Calls callback count times, the way a DDS Manager listener does, and reports the cost.
+void Measure (Metrics::Report& report, const std::string& prefix, Callback callback, long long count) {
+   /// Read through a volatile so the call cannot be inlined, just as it is not in DDS Manager.
+   Callback volatile target = callback;
+
+   AMM::Tick tick;
+   tick.frame(1);
+
+   std::uint64_t allocationsBefore = AllocationCount();
+   double start = WallSeconds();
+   for (long long i = 0; i < count; ++i) target(tick, nullptr);
+   double seconds = WallSeconds() - start;
+   std::uint64_t allocations = AllocationCount() - allocationsBefore;
+
+   report
+   .Add(prefix + "_ns", seconds * 1e9 / count)
+   .Add(prefix + "_allocs", static_cast<double>(allocations) / count);
+}
+
+std::function<void(AMM::Tick&)> stdHandler;
+
+void OnTickStdFunction (AMM::Tick& tick, eprosima::fastrtps::SampleInfo_t* info) {
+   stdHandler(tick);
+}
+
+Module::Dispatcher<AMM::Tick> single;
+
+void OnTickSingle (AMM::Tick& tick, eprosima::fastrtps::SampleInfo_t* info) {
+   single.Dispatch(tick);
+}
+
+} // namespace
+
+/// Cost of calling subscriber callbacks.
+///
+/// Each variant is called --count times through a function pointer, as DDS Manager calls a
+/// subscriber callback, and reports nanoseconds and heap allocations per sample:
+///
+///   pointer       the plain function DDSManager<void> supports today
+///   function      a capturing lambda in a std::function
+///   dispatcher    a Module::Dispatcher with one capturing lambda
+///   fanout        Dispatch<T> with --handlers capturing lambdas and member functions
+int Dispatch (const Options& opts) {
+   auto count = opts.GetInt("count", 10000000);
+   auto handlers = opts.GetInt("handlers", 8);
+   auto format = Metrics::ParseFormat(opts.Get("format", "text"));
+
+   long long lambdaSeen = 0;
+   Receiver receiver;
+
+   stdHandler = [&lambdaSeen](AMM::Tick& tick) { lambdaSeen += tick.frame(); };
+
+   /// The handlers refer to locals, so they are unsubscribed when these go out of scope.
+   std::vector<Module::Dispatcher<AMM::Tick>::Subscription> subscriptions;
+   subscriptions.push_back(single.Subscribe([&lambdaSeen](AMM::Tick& tick) { lambdaSeen += tick.frame(); }));
+
+   auto& fanout = Module::Dispatcher<AMM::Tick>::Get();
+   for (long long i = 0; i < handlers; ++i) {
+      if (i % 2 == 0) subscriptions.push_back(fanout.Subscribe([&lambdaSeen](AMM::Tick& tick) { lambdaSeen += tick.frame(); }));
+      else subscriptions.push_back(fanout.Subscribe(&receiver, &Receiver::OnTick));
+   }
+
+   Metrics::Report report("dispatch");
+   report
+   .Add("count", static_cast<std::int64_t>(count))
+   .Add("handlers", static_cast<std::int64_t>(handlers));
+
+   Measure(report, "pointer", &OnTick, count);
+   Measure(report, "function", &OnTickStdFunction, count);
+   Measure(report, "dispatcher", &OnTickSingle, count);
+   Measure(report, "fanout", &Module::Dispatch<AMM::Tick>, count);
+
+   report.Print(std::cout, format);
+
+   /// Keeps the handlers' work observable.
+   if (ticksSeen + lambdaSeen + receiver.seen == 0) std::cout << "no calls" << std::endl;
+
+   /// Unsubscribe before stdHandler's captures go too, so nothing is left referring to them.
+   subscriptions.clear();
+   stdHandler = nullptr;
+   return 0;
+}
+
+} // namespace Bench
@@ -0,0 +1,157 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <amm_std.h>
+
+#include "Benchmarks/Bench.h"
+#include "Module/HandoffQueue.h"
+#include "Module/RunLoop.h"
+
+namespace Bench {
+
+namespace {
+
+/// What the producer pushes: a plain integer, or a Module Configuration whose
+/// capabilities_configuration holds --sample-bytes of text, standing in for a whole XML file.
+template <typename T>
+struct Sample;
+
+template <>
+struct Sample<long long> {
+   static long long Make (const Options&) { return 0; }
+   static void Stamp (long long& sample, long long i) { sample = i; }
+};
+
+template <>
+struct Sample<AMM::ModuleConfiguration> {
+   static AMM::ModuleConfiguration Make (const Options& opts) {
+      AMM::ModuleConfiguration config;
+      config.name("Example Module");
+      config.capabilities_configuration(std::string(static_cast<std::size_t>(opts.GetInt("sample-bytes", 16384)), 'x'));
+      return config;
+   }
+   static void Stamp (AMM::ModuleConfiguration& sample, long long i) { sample.timestamp(i); }
+};
+
+template <typename T>
+int RunHandoff (const Options& opts, const std::string& sampleName);
+
+} // namespace
+
+/// Listener-to-module handoff.
+///
+/// A producer thread stands in for a DDS listener and pushes --count samples at --rate per
+/// second into a HandoffQueue. The loop-side handler busy-waits --work-us per sample to model
+/// module logic. Reports the time the producer spent per push, handoff latency, peak queue
+/// depth and drops.
+///
+/// --policy=drop|block selects the overflow policy. --policy=post uses RunLoop::Post instead,
+/// which is the mutex-guarded path the queue replaces.
+///
+/// --sample=config pushes Module Configuration samples of --sample-bytes instead of integers,
+/// and allocs_per_sample shows what handing off a large AMM type costs in heap allocations.
+int Handoff (const Options& opts) {
+   std::string sample = opts.Get("sample", "int");
+   if (sample == "config") return RunHandoff<AMM::ModuleConfiguration>(opts, sample);
+   return RunHandoff<long long>(opts, "int");
+}
+
+namespace {
+
+template <typename T>
+int RunHandoff (const Options& opts, const std::string& sampleName) {
+   std::string policy = opts.Get("policy", "drop");
+   auto count = opts.GetInt("count", 100000);
+   double rate = opts.GetDouble("rate", 10000.0);
+   auto capacity = opts.GetInt("capacity", 1024);
+   double workUs = opts.GetDouble("work-us", 0.0);
+
+   using Clock = Module::RunLoop::Clock;
+
+   auto work = [workUs]() {
+      if (workUs <= 0) return;
+      auto until = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+         std::chrono::duration<double, std::micro>(workUs));
+      while (Clock::now() < until) {}
+   };
+
+   Module::RunLoop loop;
+   std::atomic<std::uint64_t> handled(0);
+
+   Module::HandoffQueue<T> queue(
+      loop, static_cast<std::size_t>(capacity),
+      policy == "block" ? Module::OverflowPolicy::Block : Module::OverflowPolicy::DropOldest,
+      [&](T&) { work(); handled++; }
+   );
+
+   T value = Sample<T>::Make(opts);
+
+   std::thread t([&]() { loop.Run(); });
+   while (!loop.IsRunning()) std::this_thread::yield();
+
+   auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rate));
+   auto next = Clock::now();
+   Clock::duration pushTime(0);
+   std::uint64_t allocationsBefore = AllocationCount();
+
+   for (long long i = 0; i < count; ++i) {
+      while (Clock::now() < next) {}
+      next += interval;
+
+      auto start = Clock::now();
+      if (policy == "post") {
+         Sample<T>::Stamp(value, i);
+         loop.Post([&work, &handled, value]() { work(); handled++; });
+      } else {
+         Sample<T>::Stamp(value, i);
+         queue.Push(value);
+      }
+      pushTime += Clock::now() - start;
+   }
+
+   /// Let the loop finish what is still queued.
+   auto stats = queue.GetStats();
+   for (int i = 0; i < 5000; ++i) {
+      stats = queue.GetStats();
+      if (handled + stats.dropped >= static_cast<std::uint64_t>(count)) break;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+   }
+
+   std::uint64_t allocations = AllocationCount() - allocationsBefore;
+
+   loop.Stop();
+   t.join();
+
+   using std::chrono::duration;
+   double pushNs = duration<double, std::nano>(pushTime).count() / count;
+
+   std::cout
+   << "handoff"
+   << " policy=" << policy
+   << " sample=" << sampleName
+   << " count=" << count
+   << " rate=" << rate
+   << " push_ns=" << pushNs
+   << " handled=" << handled
+   << " allocs_per_sample=" << static_cast<double>(allocations) / count;
+
+   if (policy != "post") {
+      double meanUs = stats.delivered
+         ? duration<double, std::micro>(stats.latencyTotal).count() / stats.delivered : 0.0;
+      std::cout
+      << " dropped=" << stats.dropped
+      << " max_depth=" << stats.maxDepth
+      << " latency_mean_us=" << meanUs
+      << " latency_max_us=" << duration<double, std::micro>(stats.latencyMax).count();
+   }
+   std::cout << std::endl;
+
+   return 0;
+}
+
+} // namespace
+
+} // namespace Bench
@@ -0,0 +1,100 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <amm_std.h>
+
+#include "Benchmarks/Bench.h"
+#include "Metrics/Histogram.h"
+#include "Metrics/Report.h"
+#include "Module/HandoffQueue.h"
+#include "Module/Inbox.h"
+#include "Module/RunLoop.h"
+
+namespace Bench {
+
+/// Cost per sample of sequential module logic against the callback model.
+///
+/// A producer thread stands in for a DDS listener and delivers --count Ticks at --rate per
+/// second. --mode=inbox hands them to a Module::Inbox that a module thread waits on with
+/// NextTick. --mode=callback hands them to a HandoffQueue whose handler runs on a RunLoop, as
+/// in Tutorial 7. Reports delivery latency, producer time per sample, and process CPU per
+/// sample.
+int Inbox (const Options& opts) {
+   std::string mode = opts.Get("mode", "inbox");
+   auto count = opts.GetInt("count", 100000);
+   double rate = opts.GetDouble("rate", 20000.0);
+   auto format = Metrics::ParseFormat(opts.Get("format", "text"));
+
+   using Clock = Module::RunLoop::Clock;
+
+   std::vector<Clock::time_point> sent(static_cast<std::size_t>(count));
+   Metrics::Histogram latency;
+   std::atomic<long long> handled(0);
+
+   auto handle = [&](AMM::Tick& tick) {
+      auto elapsed = Clock::now() - sent[static_cast<std::size_t>(tick.frame())];
+      latency.Record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+      handled++;
+   };
+
+   AMM::UUID moduleId;
+   moduleId.id("inbox-benchmark");
+   Module::Inbox inbox(&moduleId, static_cast<std::size_t>(count));
+
+   Module::RunLoop loop;
+   Module::HandoffQueue<AMM::Tick> queue(loop, 1024, Module::OverflowPolicy::Block, handle);
+
+   std::thread module;
+   if (mode == "callback") {
+      module = std::thread([&]() { loop.Run(); });
+      while (!loop.IsRunning()) std::this_thread::yield();
+   } else {
+      module = std::thread([&]() {
+         AMM::Tick tick;
+         while (inbox.NextTick(tick)) handle(tick);
+      });
+   }
+
+   double cpuStart = CpuSeconds();
+   auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rate));
+   auto next = Clock::now();
+   Clock::duration pushTime(0);
+
+   AMM::Tick tick;
+   for (long long i = 0; i < count; ++i) {
+      while (Clock::now() < next) std::this_thread::yield();
+      next += interval;
+
+      tick.frame(i);
+      auto start = Clock::now();
+      sent[static_cast<std::size_t>(i)] = start;
+      if (mode == "callback") queue.Push(tick);
+      else inbox.OnTick(tick);
+      pushTime += Clock::now() - start;
+   }
+
+   for (int i = 0; i < 5000 && handled < count; ++i) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+   double cpu = CpuSeconds() - cpuStart;
+
+   if (mode == "callback") loop.Stop();
+   else inbox.Stop();
+   module.join();
+
+   Metrics::Report report("inbox");
+   report
+   .Add("mode", mode)
+   .Add("count", static_cast<std::int64_t>(count))
+   .Add("rate", rate)
+   .Add("handled", static_cast<std::int64_t>(handled.load()))
+   .Add("push_ns", std::chrono::duration<double, std::nano>(pushTime).count() / count)
+   .AddLatency("latency", latency)
+   .Add("cpu_us_per_sample", cpu * 1e6 / count);
+   report.Print(std::cout, format);
+   return 0;
+}
+
+} // namespace Bench
@@ -0,0 +1,133 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmarks/Bench.h"
+#include "Metrics/Histogram.h"
+#include "Metrics/Report.h"
+#include "Module/Logger.h"
+#include "Module/Participant.h"
+
+namespace Bench {
+
+/// Cost of logging from a subscriber callback.
+///
+/// --threads threads stand in for DDS listener threads, each logging --count lines in the
+/// style of the tutorial callbacks. Reports the time each call took.
+///
+/// --mode=cout writes each line with std::cout and std::endl, as the callbacks used to.
+/// --mode=async hands each line to a Module::Logger.
+/// --file=PATH writes to a file instead of the console in both modes.
+/// --capacity sets the Logger's buffer, by default the Logger's own 4096, so dropped shows
+/// how often callers outrun the writer thread. Set it to threads * count to keep every line.
+/// --publish=on also publishes each batch as AMM Log, as Tutorial 7 does.
+///
+/// Results go to standard error so the log itself can be sent to /dev/null:
+///   AMMBenchmarks logging --mode=async > /dev/null
+int Logging (const Options& opts) {
+   std::string mode = opts.Get("mode", "async");
+   auto threads = opts.GetInt("threads", 4);
+   auto count = opts.GetInt("count", 100000);
+   auto capacity = opts.GetInt("capacity", static_cast<long long>(Module::Logger::Options().capacity));
+   bool publish = opts.Get("publish", "off") != "off";
+   std::string file = opts.Get("file", "");
+   auto format = Metrics::ParseFormat(opts.Get("format", "text"));
+
+   using Clock = std::chrono::steady_clock;
+
+   std::ofstream fileStream;
+   if (mode == "cout" && !file.empty()) fileStream.open(file);
+   std::ostream& out = file.empty() ? std::cout : fileStream;
+
+   Module::Logger::Options options;
+   options.console = file.empty();
+   options.file = file;
+   options.capacity = static_cast<std::size_t>(capacity);
+
+   Metrics::Report report("logging");
+   report
+   .Add("mode", mode)
+   .Add("threads", static_cast<std::int64_t>(threads))
+   .Add("lines", static_cast<std::int64_t>(threads * count));
+
+   auto run = [&](Module::Logger* logger) {
+      std::vector<Metrics::Histogram> callTimes(static_cast<std::size_t>(threads));
+      std::vector<std::thread> workers;
+
+      double start = WallSeconds();
+      double cpuStart = CpuSeconds();
+
+      for (long long t = 0; t < threads; ++t) {
+         workers.emplace_back([&, t]() {
+            Metrics::Histogram& times = callTimes[static_cast<std::size_t>(t)];
+            for (long long i = 0; i < count; ++i) {
+               auto before = Clock::now();
+               if (logger) {
+                  logger->Info("Tick Count: " + std::to_string(i));
+               } else {
+                  out << "Tick Count: " << i << std::endl;
+               }
+               times.Record(static_cast<std::uint64_t>(
+                  std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - before).count()
+               ));
+            }
+         });
+      }
+      for (auto& worker : workers) worker.join();
+
+      double callersDone = WallSeconds() - start;
+      if (logger) logger->Flush();
+      double allWritten = WallSeconds() - start;
+      double cpu = CpuSeconds() - cpuStart;
+
+      Metrics::Histogram all;
+      for (auto& times : callTimes) all.Merge(times);
+
+      report
+      .AddLatency("call", all)
+      .Add("callers_s", callersDone)
+      .Add("written_s", allWritten)
+      .Add("cpu_us_per_line", cpu * 1e6 / (threads * count));
+   };
+
+   if (mode == "async") {
+      Module::Logger logger(options);
+
+      std::unique_ptr<Module::Participant> participant;
+      if (publish) {
+         participant.reset(new Module::Participant("Config/Config.xml"));
+         auto* mgr = participant->Get();
+         participant->Use([mgr]() { return mgr->InitializeLog(); }, [mgr]() { mgr->DecommissionLog(); });
+         mgr->CreateLogPublisher();
+
+         AMM::UUID moduleId;
+         moduleId.id(AMM::DDSManager<void>::GenerateUuidString());
+         logger.PublishTo(mgr, moduleId);
+      }
+
+      run(&logger);
+
+      auto stats = logger.GetStats();
+      if (participant) {
+         logger.PublishTo(nullptr, AMM::UUID());
+         participant->Close();
+      }
+
+      report
+      .Add("capacity", static_cast<std::int64_t>(capacity))
+      .Add("dropped", stats.dropped)
+      .Add("batches", stats.batches)
+      .Add("published", stats.published);
+   } else {
+      run(nullptr);
+   }
+
+   report.Print(std::cerr, format);
+   return 0;
+}
+
+} // namespace Bench
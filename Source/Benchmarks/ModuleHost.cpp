@@ -0,0 +1,130 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <amm_std.h>
+
+#include "Benchmarks/Bench.h"
+#include "Metrics/Report.h"
+#include "Module/ModuleHost.h"
+#include "Module/Participant.h"
+#include "Module/RunLoop.h"
+
+namespace Bench {
+
+namespace {
+
+void IgnoreSimulationControl (AMM::SimulationControl&, eprosima::fastrtps::SampleInfo_t*) {}
+void IgnoreModuleConfiguration (AMM::ModuleConfiguration&, eprosima::fastrtps::SampleInfo_t*) {}
+void IgnoreTick (AMM::Tick&, eprosima::fastrtps::SampleInfo_t*) {}
+
+AMM::OperationalDescription Describe (long long index) {
+   AMM::OperationalDescription od;
+   od.name("Hosted Module " + std::to_string(index));
+   od.manufacturer("Vcom3D");
+   od.model("Hosted Module");
+   AMM::UUID id;
+   id.id("module-host-" + std::to_string(index));
+   od.module_id(id);
+   return od;
+}
+
+} // namespace
+
+/// Participants, threads and memory for N logical modules.
+///
+/// --mode=separate gives each module its own DDS Manager, as in Tutorial 4. --mode=host puts
+/// all of them on one Participant through a Module::ModuleHost. Either way each module
+/// subscribes to Simulation Control, Module Configuration and Tick and publishes its
+/// Operational Description. After --settle-ms for discovery threads to start, reports
+/// participants, threads, and resident memory in total and per module. In host mode the
+/// threads include the RunLoop that runs the host's publisher gates.
+///
+/// Participants cannot be recreated within a process, so run once per --modules value:
+///
+///    for n in 1 2 4 8 16 32 64; do AMMBenchmarks module_host --modules=$n --mode=host; done
+int ModuleHost (const Options& opts) {
+   std::string mode = opts.Get("mode", "host");
+   auto modules = opts.GetInt("modules", 8);
+   auto settleMs = opts.GetInt("settle-ms", 1000);
+   auto format = Metrics::ParseFormat(opts.Get("format", "text"));
+
+   int threadsBefore = ThreadCount();
+   std::uint64_t residentBefore = ResidentBytes();
+   double start = WallSeconds();
+
+   std::vector<AMM::DDSManager<void>*> managers;
+   Module::Participant* participant = nullptr;
+   Module::ModuleHost* host = nullptr;
+   Module::RunLoop loop;
+   std::thread loopThread;
+
+   if (mode == "separate") {
+      for (long long i = 0; i < modules; ++i) {
+         auto* mgr = new AMM::DDSManager<void>("Config/Config.xml");
+         mgr->InitializeOperationalDescription();
+         mgr->InitializeSimulationControl();
+         mgr->InitializeModuleConfiguration();
+         mgr->InitializeTick();
+         mgr->CreateOperationalDescriptionPublisher();
+         mgr->CreateSimulationControlSubscriber(&IgnoreSimulationControl);
+         mgr->CreateModuleConfigurationSubscriber(&IgnoreModuleConfiguration);
+         mgr->CreateTickSubscriber(&IgnoreTick);
+
+         AMM::OperationalDescription od = Describe(i);
+         mgr->WriteOperationalDescription(od);
+         managers.push_back(mgr);
+      }
+   } else {
+      loopThread = std::thread([&loop]() { loop.Run(); });
+      participant = new Module::Participant("Config/Config.xml");
+      host = new Module::ModuleHost(*participant, loop);
+      for (long long i = 0; i < modules; ++i) {
+         Module::ModuleHost::Callbacks callbacks;
+         callbacks.simulationControl = [](AMM::SimulationControl&) {};
+         callbacks.moduleConfiguration = [](AMM::ModuleConfiguration&) {};
+         callbacks.tick = [](AMM::Tick&) {};
+         host->Add(Describe(i), callbacks);
+      }
+      if (host->Start() != 0) {
+         std::cout << "Could not start the module host." << std::endl;
+         return 1;
+      }
+   }
+
+   double setupSeconds = WallSeconds() - start;
+   std::this_thread::sleep_for(std::chrono::milliseconds(settleMs));
+
+   int threads = ThreadCount() - threadsBefore;
+   double residentMb = (static_cast<double>(ResidentBytes()) - residentBefore) / (1024.0 * 1024.0);
+
+   Metrics::Report report("module_host");
+   report
+   .Add("mode", mode)
+   .Add("modules", static_cast<std::int64_t>(modules))
+   .Add("participants", static_cast<std::int64_t>(mode == "separate" ? modules : 1))
+   .Add("threads", threads)
+   .Add("threads_per_module", static_cast<double>(threads) / modules)
+   .Add("rss_mb", residentMb)
+   .Add("rss_kb_per_module", residentMb * 1024.0 / modules)
+   .Add("setup_s", setupSeconds);
+   report.Print(std::cout, format);
+
+   /// Shut down once, at the end. See the Shutdown note in ExampleModule.cpp.
+   if (participant != nullptr) {
+      participant->Close();
+      loop.Stop();
+      loopThread.join();
+      delete host;
+      delete participant;
+   }
+   for (auto* mgr : managers) {
+      mgr->Shutdown();
+      delete mgr;
+   }
+   return 0;
+}
+
+} // namespace Bench
@@ -0,0 +1,119 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include <amm_std.h>
+
+#include "Benchmarks/Bench.h"
+#include "Metrics/Histogram.h"
+#include "Metrics/Report.h"
+#include "Module/Participant.h"
+
+namespace Bench {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::atomic<long long> lastReceived(-1);
+
+void OnAssessment (AMM::Assessment& assessment, eprosima::fastrtps::SampleInfo_t* info) {
+   lastReceived = std::atoll(assessment.comment().c_str());
+}
+
+/// Writes until the listener has seen this cycle's sample or the timeout passes.
+/// A new publisher drops writes until it is matched, so the first write alone is not enough.
+bool WriteUntilReceived (AMM::DDSManager<void>* mgr, long long cycle, std::chrono::milliseconds timeout) {
+   AMM::Assessment assessment;
+   assessment.comment(std::to_string(cycle));
+
+   auto deadline = Clock::now() + timeout;
+   while (Clock::now() < deadline) {
+      mgr->WriteAssessment(assessment);
+      for (int i = 0; i < 5; ++i) {
+         if (lastReceived == cycle) return true;
+         std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+   }
+   return false;
+}
+
+} // namespace
+
+/// Create, publish, tear down, repeat.
+///
+/// A listener participant subscribes to Assessment. Each cycle then sets up an Assessment
+/// publisher, writes until the listener receives that cycle's sample, and tears it down.
+///
+/// --mode=session keeps one Module::Participant and closes its session each cycle.
+/// --mode=recreate creates a new DDS Manager each cycle and calls Shutdown on it, which
+/// shows the known issue: after the first cycle, samples stop arriving.
+///
+/// Reports cycle time and resident memory after --warmup cycles and at the end. Fails when
+/// a sample is lost or memory grows by more than --max-growth-kb.
+int ParticipantCycle (const Options& opts) {
+   std::string mode = opts.Get("mode", "session");
+   auto cycles = opts.GetInt("cycles", 1000);
+   auto warmup = opts.GetInt("warmup", 20);
+   auto timeoutMs = opts.GetInt("timeout-ms", 2000);
+   auto maxGrowthKb = opts.GetInt("max-growth-kb", 1024);
+   auto format = Metrics::ParseFormat(opts.Get("format", "text"));
+
+   Module::Participant listener("Config/Config.xml");
+   listener.Use([&]() { return listener->InitializeAssessment(); },
+                [&]() { listener->DecommissionAssessment(); });
+   listener->CreateAssessmentSubscriber(&OnAssessment);
+
+   Module::Participant* participant = nullptr;
+   if (mode == "session") participant = new Module::Participant("Config/Config.xml");
+
+   Metrics::Histogram cycleTime;
+   long long delivered = 0;
+   std::uint64_t residentAfterWarmup = ResidentBytes();
+
+   for (long long cycle = 0; cycle < cycles; ++cycle) {
+      if (cycle == warmup) residentAfterWarmup = ResidentBytes();
+      auto start = Clock::now();
+
+      if (participant) {
+         AMM::DDSManager<void>* mgr = participant->Get();
+         participant->Use([mgr]() { return mgr->InitializeAssessment(); },
+                          [mgr]() { mgr->DecommissionAssessment(); });
+         mgr->CreateAssessmentPublisher();
+         if (WriteUntilReceived(mgr, cycle, std::chrono::milliseconds(timeoutMs))) delivered++;
+         participant->Close();
+      } else {
+         AMM::DDSManager<void>* mgr = new AMM::DDSManager<void>("Config/Config.xml");
+         mgr->InitializeAssessment();
+         mgr->CreateAssessmentPublisher();
+         if (WriteUntilReceived(mgr, cycle, std::chrono::milliseconds(timeoutMs))) delivered++;
+         mgr->Shutdown();
+         delete mgr;
+      }
+
+      cycleTime.Record(static_cast<std::uint64_t>(
+         std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count()
+      ));
+   }
+
+   std::uint64_t residentEnd = ResidentBytes();
+   double growthKb = (static_cast<double>(residentEnd) - static_cast<double>(residentAfterWarmup)) / 1024.0;
+
+   Metrics::Report report("participant_cycle");
+   report
+   .Add("mode", mode)
+   .Add("cycles", static_cast<std::int64_t>(cycles))
+   .Add("delivered", static_cast<std::int64_t>(delivered))
+   .AddLatency("cycle", cycleTime)
+   .Add("resident_after_warmup_kb", residentAfterWarmup / 1024)
+   .Add("resident_end_kb", residentEnd / 1024)
+   .Add("growth_kb", growthKb)
+   .Add("growth_bytes_per_cycle", cycles > warmup ? growthKb * 1024.0 / (cycles - warmup) : 0.0);
+   report.Print(std::cout, format);
+
+   delete participant;
+   return (delivered == cycles && growthKb <= maxGrowthKb) ? 0 : 1;
+}
+
+} // namespace Bench
@@ -0,0 +1,124 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "Benchmarks/Bench.h"
+#include "Metrics/Histogram.h"
+#include "Metrics/Report.h"
+#include "Module/HandoffQueue.h"
+#include "Module/RunLoop.h"
+#include "Module/SimStateMachine.h"
+
+namespace Bench {
+
+namespace {
+
+struct ControlSample {
+   std::uint32_t generation;
+   Module::RunLoop::Clock::time_point pushed;
+};
+
+} // namespace
+
+/// Simulation Control latency under saturating bulk load.
+///
+/// A flood thread pushes bulk samples at --bulk-rate per second into a HandoffQueue whose
+/// handler busy-waits --work-us per sample, which is more than the loop can keep up with at
+/// the defaults. A control thread alternates HALT and RUN every --toggle-ms, applying each on
+/// the state machine and pushing it through a second queue, the way Tutorial 7 does. The
+/// control handler marks the effect. Reports push-to-handled latency for control samples and
+/// the bulk throughput the loop kept up.
+///
+/// --lanes=on gives control its own Control priority queue and bulk the Bulk priority.
+/// --lanes=off puts both at Normal priority, with control registered after bulk.
+int Priority (const Options& opts) {
+   double duration = opts.GetDouble("duration", 3.0);
+   double bulkRate = opts.GetDouble("bulk-rate", 50000.0);
+   double workUs = opts.GetDouble("work-us", 40.0);
+   auto toggleMs = opts.GetInt("toggle-ms", 10);
+   bool lanes = opts.Get("lanes", "on") != "off";
+   auto format = Metrics::ParseFormat(opts.Get("format", "text"));
+
+   using Clock = Module::RunLoop::Clock;
+   using Priority = Module::RunLoop::Priority;
+
+   Module::RunLoop loop;
+   Module::SimStateMachine sim;
+   Metrics::Histogram controlLatency;
+   std::atomic<std::uint64_t> bulkHandled(0);
+
+   Module::HandoffQueue<long long> bulk(
+      loop, 4096, Module::OverflowPolicy::DropOldest,
+      [&](long long&) {
+         auto until = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double, std::micro>(workUs));
+         while (Clock::now() < until) {}
+         bulkHandled++;
+      },
+      lanes ? Priority::Bulk : Priority::Normal
+   );
+
+   Module::HandoffQueue<ControlSample> control(
+      loop, 64, Module::OverflowPolicy::Block,
+      [&](ControlSample& sample) {
+         sim.MarkEffect(sample.generation);
+         controlLatency.Record(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - sample.pushed).count()));
+      },
+      lanes ? Priority::Control : Priority::Normal
+   );
+
+   std::thread loopThread([&]() { loop.Run(); });
+   while (!loop.IsRunning()) std::this_thread::yield();
+
+   std::atomic<bool> running(true);
+   std::uint64_t bulkSent = 0;
+
+   std::thread flood([&]() {
+      auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / bulkRate));
+      auto next = Clock::now();
+      while (running) {
+         while (Clock::now() < next) {}
+         next += interval;
+         bulk.Push(static_cast<long long>(bulkSent++));
+      }
+   });
+
+   std::thread controller([&]() {
+      bool run = false;
+      while (running) {
+         std::this_thread::sleep_for(std::chrono::milliseconds(toggleMs));
+         auto state = sim.Apply(run ? Module::SimEvent::Run : Module::SimEvent::Halt);
+         control.Push(ControlSample{state.generation, Clock::now()});
+         run = !run;
+      }
+   });
+
+   std::this_thread::sleep_for(std::chrono::duration<double>(duration));
+   running = false;
+   flood.join();
+   controller.join();
+
+   loop.Stop();
+   loopThread.join();
+
+   auto halt = sim.GetLatency(Module::SimEvent::Halt);
+
+   Metrics::Report report("priority");
+   report
+   .Add("lanes", lanes ? "on" : "off")
+   .Add("bulk_rate", bulkRate)
+   .Add("work_us", workUs)
+   .Add("bulk_sent", bulkSent)
+   .Add("bulk_handled", bulkHandled.load())
+   .Add("bulk_dropped", bulk.GetStats().dropped)
+   .AddLatency("control", controlLatency)
+   .Add("halt_effect_max_us",
+        std::chrono::duration<double, std::micro>(halt.max).count());
+   report.Print(std::cout, format);
+   return 0;
+}
+
+} // namespace Bench
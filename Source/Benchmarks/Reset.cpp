@@ -0,0 +1,104 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <amm_std.h>
+
+#include "Benchmarks/Bench.h"
+#include "Module/DoubleBuffer.h"
+#include "Module/Versioned.h"
+
+namespace Bench {
+
+namespace {
+
+/// Module State as Tutorial 7 kept it before snapshots: every RESET deep copies it.
+struct DeepState {
+   AMM::ModuleConfiguration mc;
+   std::vector<AMM::Status> statuses;
+   int tickCount = 0;
+};
+
+/// Module State with shared, versioned parts: RESET copies pointers.
+struct VersionedState {
+   Module::Versioned<AMM::ModuleConfiguration> mc;
+   Module::Versioned<std::vector<AMM::Status>> statuses;
+   int tickCount = 0;
+};
+
+} // namespace
+
+/// Cost of Simulation Control RESET.
+///
+/// Builds a default Module State with a --config-bytes capabilities configuration and
+/// --capabilities Status entries. Each of --count rounds applies a configuration change,
+/// as scenario authoring does, then restores the defaults. --mode=deep assigns a plain
+/// struct, as Tutorial 7 did. --mode=versioned stores a snapshot with Versioned parts into a
+/// DoubleBuffer, as Tutorial 7 does now. Reports time and heap allocations per RESET.
+int Reset (const Options& opts) {
+   std::string mode = opts.Get("mode", "versioned");
+   auto count = opts.GetInt("count", 100000);
+   auto configBytes = opts.GetInt("config-bytes", 65536);
+   auto capabilities = opts.GetInt("capabilities", 32);
+
+   AMM::ModuleConfiguration mc;
+   mc.name("Reset Benchmark");
+   mc.capabilities_configuration(std::string(static_cast<std::size_t>(configBytes), 'x'));
+
+   AMM::ModuleConfiguration changed = mc;
+   changed.capabilities_configuration(std::string(static_cast<std::size_t>(configBytes) / 2, 'y'));
+
+   std::vector<AMM::Status> statuses(static_cast<std::size_t>(capabilities));
+   for (std::size_t i = 0; i < statuses.size(); ++i) {
+      statuses[i].capability("Capability " + std::to_string(i));
+      statuses[i].message("Ready");
+   }
+
+   std::uint64_t allocs = 0;
+   double seconds = 0.0;
+
+   if (mode == "deep") {
+      DeepState defaults;
+      defaults.mc = mc;
+      defaults.statuses = statuses;
+      DeepState current = defaults;
+
+      std::uint64_t allocStart = AllocationCount();
+      double start = WallSeconds();
+      for (long long i = 0; i < count; ++i) {
+         current.mc = changed;
+         current = defaults;
+      }
+      seconds = WallSeconds() - start;
+      allocs = AllocationCount() - allocStart;
+   } else {
+      VersionedState defaults;
+      defaults.mc = Module::Versioned<AMM::ModuleConfiguration>(mc);
+      defaults.statuses = Module::Versioned<std::vector<AMM::Status>>(statuses);
+      Module::DoubleBuffer<VersionedState> current(defaults);
+      Module::Versioned<AMM::ModuleConfiguration> changedVersion(changed);
+
+      std::uint64_t allocStart = AllocationCount();
+      double start = WallSeconds();
+      for (long long i = 0; i < count; ++i) {
+         current.Modify([&](VersionedState& state) { state.mc = changedVersion; });
+         current.Store(defaults);
+      }
+      seconds = WallSeconds() - start;
+      allocs = AllocationCount() - allocStart;
+   }
+
+   std::cout
+   << "reset"
+   << " mode=" << mode
+   << " config_bytes=" << configBytes
+   << " capabilities=" << capabilities
+   << " ns_per_reset=" << (seconds * 1e9 / count)
+   << " allocs_per_reset=" << (static_cast<double>(allocs) / count)
+   << std::endl;
+
+   return 0;
+}
+
+} // namespace Bench
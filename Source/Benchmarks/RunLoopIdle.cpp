@@ -0,0 +1,63 @@
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+#include "Benchmarks/Bench.h"
+#include "Module/RunLoop.h"
+
+namespace Bench {
+
+/// Idle CPU of a module keep-alive loop.
+///
+/// Runs the loop for --duration seconds with nothing to do except an optional
+/// --timer-hz timer, and reports the process CPU usage over that window.
+/// --spin runs the old `for (;;) { if (!isRunning) break; }` loop for comparison.
+int RunLoopIdle (const Options& opts) {
+   double duration = opts.GetDouble("duration", 5.0);
+   double timerHz = opts.GetDouble("timer-hz", 0.0);
+   bool spin = opts.Has("spin");
+
+   double cpuStart = CpuSeconds();
+   double wallStart = WallSeconds();
+   std::uint64_t wakeups = 0;
+
+   if (spin) {
+      std::atomic<bool> isRunning(true);
+      std::thread t([&]() {
+         for (;;) {
+            if (!isRunning) break;
+         }
+      });
+      std::this_thread::sleep_for(std::chrono::duration<double>(duration));
+      isRunning = false;
+      t.join();
+   } else {
+      Module::RunLoop loop;
+      if (timerHz > 0) {
+         auto period = std::chrono::duration_cast<Module::RunLoop::Clock::duration>(
+            std::chrono::duration<double>(1.0 / timerHz));
+         loop.PostEvery(period, []() {});
+      }
+      std::thread t([&]() { loop.Run(); });
+      std::this_thread::sleep_for(std::chrono::duration<double>(duration));
+      loop.Stop();
+      t.join();
+      wakeups = loop.Wakeups();
+   }
+
+   double cpu = CpuSeconds() - cpuStart;
+   double wall = WallSeconds() - wallStart;
+
+   std::cout
+   << "run_loop_idle"
+   << " mode=" << (spin ? "spin" : "blocking")
+   << " wall_s=" << wall
+   << " cpu_s=" << cpu
+   << " cpu_pct=" << (100.0 * cpu / wall)
+   << " wakeups=" << wakeups
+   << std::endl;
+
+   return 0;
+}
+
+} // namespace Bench
@@ -0,0 +1,94 @@
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include <amm_std.h>
+
+#include "Benchmarks/Bench.h"
+#include "Module/StateFile.h"
+
+namespace Bench {
+
+namespace {
+
+const std::uint32_t BenchmarkFormat = 1;
+
+/// Startup from the config files, as Tutorial 7 does without a save state.
+void BuildFromXml (AMM::OperationalDescription& od, AMM::ModuleConfiguration& mc) {
+   od.name("Save State Benchmark");
+   od.capabilities_schema(AMM::Utility::read_file_to_string("Config/CapabilitiesSchema.xml"));
+   mc.name("Save State Benchmark");
+   mc.capabilities_configuration(AMM::Utility::read_file_to_string("Config/CapabilitiesConfiguration.xml"));
+}
+
+} // namespace
+
+/// Save and restore cost of module state.
+///
+/// Compares building Operational Description and Module Configuration from the Config XML
+/// files against restoring them from a binary state file, and reports the cost of writing
+/// that file. Run from the directory that holds Config. --pad-bytes grows the capabilities
+/// configuration to model larger modules.
+int SaveState (const Options& opts) {
+   auto count = opts.GetInt("count", 1000);
+   auto padBytes = opts.GetInt("pad-bytes", 0);
+   std::string path = opts.Get("path", "AMMBenchmarks.state");
+
+   AMM::OperationalDescription od;
+   AMM::ModuleConfiguration mc;
+   BuildFromXml(od, mc);
+   if (padBytes > 0) {
+      mc.capabilities_configuration(
+         mc.capabilities_configuration() + std::string(static_cast<std::size_t>(padBytes), ' ')
+      );
+   }
+
+   double start = WallSeconds();
+   for (long long i = 0; i < count; ++i) {
+      AMM::OperationalDescription xmlOd;
+      AMM::ModuleConfiguration xmlMc;
+      BuildFromXml(xmlOd, xmlMc);
+   }
+   double xmlUs = (WallSeconds() - start) * 1e6 / count;
+
+   std::size_t fileBytes = 0;
+   start = WallSeconds();
+   for (long long i = 0; i < count; ++i) {
+      Module::StateWriter writer(BenchmarkFormat);
+      writer.Write(od).Write(mc);
+      fileBytes = writer.Size();
+      std::string errmsg;
+      if (writer.Save(path, errmsg) != 0) {
+         std::cout << errmsg << std::endl;
+         return 1;
+      }
+   }
+   double saveUs = (WallSeconds() - start) * 1e6 / count;
+
+   start = WallSeconds();
+   for (long long i = 0; i < count; ++i) {
+      Module::StateReader reader;
+      AMM::OperationalDescription savedOd;
+      AMM::ModuleConfiguration savedMc;
+      std::string errmsg;
+      if (reader.Load(path, BenchmarkFormat, errmsg) != 0
+          || reader.Read(savedOd, errmsg) != 0
+          || reader.Read(savedMc, errmsg) != 0) {
+         std::cout << errmsg << std::endl;
+         return 1;
+      }
+   }
+   double loadUs = (WallSeconds() - start) * 1e6 / count;
+
+   std::cout
+   << "save_state"
+   << " file_bytes=" << fileBytes
+   << " xml_startup_us=" << xmlUs
+   << " save_us=" << saveUs
+   << " restore_us=" << loadUs
+   << std::endl;
+
+   return 0;
+}
+
+} // namespace Bench
@@ -0,0 +1,127 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "Benchmarks/Bench.h"
+#include "Module/DoubleBuffer.h"
+#include "Module/HandoffQueue.h"
+#include "Module/RunLoop.h"
+#include "Module/SimStateMachine.h"
+
+namespace Bench {
+
+namespace {
+
+/// Stand-in for a module state with a large configuration blob.
+struct State {
+   std::string config;
+   long long tickCount = 0;
+};
+
+} // namespace
+
+/// Simulation state machine and lock-free module state.
+///
+/// A producer thread feeds Ticks at --tick-hz through a HandoffQueue while a control thread
+/// toggles RUN and HALT every --toggle-ms, applying each transition the way Tutorial 7 does.
+/// The Tick handler marks effects and increments a counter in a DoubleBuffer. A reader thread
+/// reads the state continuously. Reports transition-to-effect latency per event and reader
+/// throughput, alongside a mutex-guarded copy for comparison (--mutex).
+int SimState (const Options& opts) {
+   double duration = opts.GetDouble("duration", 3.0);
+   double tickHz = opts.GetDouble("tick-hz", 1000.0);
+   auto toggleMs = opts.GetInt("toggle-ms", 10);
+   auto configBytes = opts.GetInt("config-bytes", 4096);
+   bool useMutex = opts.Has("mutex");
+
+   using Clock = Module::RunLoop::Clock;
+
+   State initial;
+   initial.config.assign(static_cast<std::size_t>(configBytes), 'x');
+
+   Module::RunLoop loop;
+   Module::SimStateMachine sim;
+   Module::DoubleBuffer<State> buffered(initial);
+   State guarded = initial;
+   std::mutex guardedMutex;
+
+   Module::HandoffQueue<long long> ticks(loop, 1024, Module::OverflowPolicy::DropOldest, [&](long long&) {
+      auto current = sim.Current();
+      sim.MarkEffect(current.generation);
+      if (!current.running) return;
+      if (useMutex) {
+         std::lock_guard<std::mutex> lock(guardedMutex);
+         guarded.tickCount++;
+      } else {
+         buffered.Modify([](State& state) { state.tickCount++; });
+      }
+   });
+
+   std::thread loopThread([&]() { loop.Run(); });
+   while (!loop.IsRunning()) std::this_thread::yield();
+
+   std::atomic<bool> running(true);
+
+   std::thread producer([&]() {
+      auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / tickHz));
+      auto next = Clock::now();
+      long long frame = 0;
+      while (running) {
+         std::this_thread::sleep_until(next);
+         next += interval;
+         ticks.Push(frame++);
+      }
+   });
+
+   std::thread control([&]() {
+      bool run = true;
+      while (running) {
+         sim.Apply(run ? Module::SimEvent::Run : Module::SimEvent::Halt);
+         run = !run;
+         std::this_thread::sleep_for(std::chrono::milliseconds(toggleMs));
+      }
+   });
+
+   std::uint64_t reads = 0;
+   std::size_t checksum = 0;
+   double start = WallSeconds();
+   while (WallSeconds() - start < duration) {
+      if (useMutex) {
+         std::lock_guard<std::mutex> lock(guardedMutex);
+         checksum += guarded.config.size() + static_cast<std::size_t>(guarded.tickCount);
+      } else {
+         auto state = buffered.Read();
+         checksum += state->config.size() + static_cast<std::size_t>(state->tickCount);
+      }
+      reads++;
+   }
+
+   running = false;
+   producer.join();
+   control.join();
+   loop.Stop();
+   loopThread.join();
+
+   auto report = [](const char* name, const Module::SimStateMachine::LatencyStats& stats) {
+      std::cout
+      << " " << name << "_count=" << stats.count
+      << " " << name << "_mean_us=" << (stats.count ? Micros(stats.total) / stats.count : 0.0)
+      << " " << name << "_max_us=" << Micros(stats.max);
+   };
+
+   std::cout
+   << "sim_state"
+   << " state=" << (useMutex ? "mutex" : "double_buffer")
+   << " reads_per_s=" << (reads / duration)
+   << " checksum=" << (checksum & 0xff);
+   report("run", sim.GetLatency(Module::SimEvent::Run));
+   report("halt", sim.GetLatency(Module::SimEvent::Halt));
+   std::cout << std::endl;
+
+   return 0;
+}
+
+} // namespace Bench
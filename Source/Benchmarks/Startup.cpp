@@ -0,0 +1,95 @@
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+#include <amm_std.h>
+
+#include "Benchmarks/Bench.h"
+#include "Module/PublisherGate.h"
+#include "Module/RunLoop.h"
+
+namespace Bench {
+
+namespace {
+
+std::atomic<double> firstReceived(0.0);
+std::atomic<int> received(0);
+
+void OnOperationalDescription (AMM::OperationalDescription& od, eprosima::fastrtps::SampleInfo_t* info) {
+   double expected = 0.0;
+   firstReceived.compare_exchange_strong(expected, WallSeconds());
+   received++;
+}
+
+} // namespace
+
+/// Time to first published Operational Description.
+///
+/// A listener participant subscribes to Operational Description, then a module participant
+/// is created and publishes its Operational Description. Reports the time from creating the
+/// module's DDS Manager until the listener receives the sample.
+///
+/// --mode=sleep writes once after --sleep-ms (the Tutorial 7 startup before gates).
+/// --mode=gate writes immediately through a PublisherGate with --resend-ms back-off.
+///
+/// Run once per process. See the Shutdown note in ExampleModule.cpp.
+int Startup (const Options& opts) {
+   std::string mode = opts.Get("mode", "gate");
+   auto sleepMs = opts.GetInt("sleep-ms", 250);
+   auto resendMs = opts.GetInt("resend-ms", 25);
+   auto timeoutMs = opts.GetInt("timeout-ms", 5000);
+
+   AMM::DDSManager<void>* listener = new AMM::DDSManager<void>("Config/Config.xml");
+   listener->InitializeOperationalDescription();
+   listener->CreateOperationalDescriptionSubscriber(&OnOperationalDescription);
+
+   Module::RunLoop loop;
+   std::thread t([&]() { loop.Run(); });
+
+   double start = WallSeconds();
+
+   AMM::DDSManager<void>* mgr = new AMM::DDSManager<void>("Config/Config.xml");
+   mgr->InitializeOperationalDescription();
+   mgr->CreateOperationalDescriptionPublisher();
+
+   AMM::OperationalDescription od;
+   od.name("Startup Benchmark");
+
+   Module::PublisherGate::Options gateOptions;
+   gateOptions.resendInterval = std::chrono::milliseconds(resendMs);
+   Module::PublisherGate gate(loop, gateOptions);
+
+   if (mode == "sleep") {
+      std::this_thread::sleep_for(std::chrono::milliseconds(sleepMs));
+      mgr->WriteOperationalDescription(od);
+   } else {
+      gate.Write([&]() { return mgr->WriteOperationalDescription(od); });
+   }
+
+   while (firstReceived == 0.0 && (WallSeconds() - start) * 1000.0 < timeoutMs) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+   }
+
+   double firstMs = firstReceived == 0.0 ? -1.0 : (firstReceived - start) * 1000.0;
+   auto stats = gate.GetStats();
+
+   std::cout
+   << "startup"
+   << " mode=" << mode
+   << " time_to_first_od_ms=" << firstMs
+   << " received=" << received
+   << " writes=" << (mode == "sleep" ? 1 : stats.writes)
+   << std::endl;
+
+   loop.Stop();
+   t.join();
+
+   mgr->Shutdown();
+   listener->Shutdown();
+   delete mgr;
+   delete listener;
+
+   return firstMs < 0 ? 1 : 0;
+}
+
+} // namespace Bench
@@ -0,0 +1,354 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <amm_std.h>
+
+#include "Benchmarks/Bench.h"
+#include "Metrics/Histogram.h"
+#include "Metrics/Report.h"
+#include "Module/Participant.h"
+#include "Module/Transport.h"
+
+namespace Bench {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Manager = AMM::DDSManager<void>;
+
+std::uint64_t NowNs () {
+   return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count()
+   );
+}
+
+
+/// Send times by sequence number. Sequence numbers keep counting across every phase of the
+/// suite, so a late sample from an earlier phase is recognised and ignored.
+const std::size_t sendTimeSlots = 1 << 20;
+std::vector<std::atomic<std::uint64_t>> sendTimes(sendTimeSlots);
+
+std::mutex receiveMutex;
+Metrics::Histogram latency;
+std::uint64_t phaseFirstSeq = 0;
+std::uint64_t received = 0;
+std::atomic<std::uint64_t> lastReceived(0);
+
+void Received (std::uint64_t seq) {
+   std::uint64_t now = NowNs();
+   std::uint64_t sent = sendTimes[seq % sendTimeSlots].load(std::memory_order_relaxed);
+
+   std::lock_guard<std::mutex> lock(receiveMutex);
+   lastReceived = seq;
+   if (seq < phaseFirstSeq) return;
+   received++;
+   if (sent != 0 && now >= sent) latency.Record(now - sent);
+}
+
+
+/// Where each type carries the sequence number and padding.
+/// Types without a free text field use a UUID string.
+std::string& Text (AMM::Assessment& s)               { return s.comment(); }
+std::string& Text (AMM::Command& s)                  { return s.message(); }
+std::string& Text (AMM::EventFragment& s)            { return s.data(); }
+std::string& Text (AMM::EventRecord& s)              { return s.data(); }
+std::string& Text (AMM::FragmentAmendmentRequest& s) { return s.id().id(); }
+std::string& Text (AMM::InstrumentData& s)           { return s.payload(); }
+std::string& Text (AMM::Log& s)                      { return s.message(); }
+std::string& Text (AMM::ModuleConfiguration& s)      { return s.capabilities_configuration(); }
+std::string& Text (AMM::OmittedEvent& s)             { return s.data(); }
+std::string& Text (AMM::OperationalDescription& s)   { return s.description(); }
+std::string& Text (AMM::PhysiologyModification& s)   { return s.data(); }
+std::string& Text (AMM::PhysiologyValue& s)          { return s.id().id(); }
+std::string& Text (AMM::PhysiologyWaveform& s)       { return s.id().id(); }
+std::string& Text (AMM::RenderModification& s)       { return s.data(); }
+std::string& Text (AMM::SimulationControl& s)        { return s.educational_encounter().id(); }
+std::string& Text (AMM::Status& s)                   { return s.message(); }
+
+template <typename T>
+void Stamp (T& sample, std::uint64_t seq, std::size_t payload) {
+   std::string& text = Text(sample);
+   text = std::to_string(seq);
+   text += ' ';
+   if (text.size() < payload) text.append(payload - text.size(), 'x');
+}
+
+template <typename T>
+std::uint64_t SequenceOf (T& sample) {
+   return std::strtoull(Text(sample).c_str(), nullptr, 10);
+}
+
+/// Tick is fixed size, so payload does not apply.
+void Stamp (AMM::Tick& sample, std::uint64_t seq, std::size_t payload) {
+   sample.frame(static_cast<long long>(seq));
+}
+
+std::uint64_t SequenceOf (AMM::Tick& sample) {
+   return static_cast<std::uint64_t>(sample.frame());
+}
+
+template <typename T>
+void OnSample (T& sample, eprosima::fastrtps::SampleInfo_t* info) {
+   Received(SequenceOf(sample));
+}
+
+
+/// DDS Manager methods for one type, so the suite can be written once as a template.
+#define BENCH_TOPIC(T) \
+struct T##Topic { \
+   using Type = AMM::T; \
+   static const char* Name () { return #T; } \
+   static int Initialize (Manager* mgr) { return mgr->Initialize##T(); } \
+   static void Decommission (Manager* mgr) { mgr->Decommission##T(); } \
+   static int CreatePublisher (Manager* mgr) { return mgr->Create##T##Publisher(); } \
+   static int CreateSubscriber (Manager* mgr) { return mgr->Create##T##Subscriber(&OnSample<AMM::T>); } \
+   static int Write (Manager* mgr, AMM::T& sample) { return mgr->Write##T(sample); } \
+};
+
+BENCH_TOPIC(Assessment)
+BENCH_TOPIC(Command)
+BENCH_TOPIC(EventFragment)
+BENCH_TOPIC(EventRecord)
+BENCH_TOPIC(FragmentAmendmentRequest)
+BENCH_TOPIC(InstrumentData)
+BENCH_TOPIC(Log)
+BENCH_TOPIC(ModuleConfiguration)
+BENCH_TOPIC(OmittedEvent)
+BENCH_TOPIC(OperationalDescription)
+BENCH_TOPIC(PhysiologyModification)
+BENCH_TOPIC(PhysiologyValue)
+BENCH_TOPIC(PhysiologyWaveform)
+BENCH_TOPIC(RenderModification)
+BENCH_TOPIC(SimulationControl)
+BENCH_TOPIC(Status)
+BENCH_TOPIC(Tick)
+
+#undef BENCH_TOPIC
+
+
+struct Settings {
+   double rate;
+   double duration;
+   double stepDuration;
+   double maxRate;
+   std::chrono::milliseconds drain;
+   std::chrono::milliseconds matchTimeout;
+   Metrics::Format format;
+   std::string transport;
+};
+
+std::uint64_t nextSeq = 1;
+
+struct PhaseResult {
+   std::uint64_t sent = 0;
+   std::uint64_t received = 0;
+   double seconds = 0.0;
+   double cpuSeconds = 0.0;
+   Metrics::Histogram latency;
+};
+
+/// Publishes at rate for duration seconds, then waits for stragglers.
+template <typename Topic>
+PhaseResult RunPhase (Manager* pub, std::size_t payload, double rate, double duration, const Settings& settings) {
+   {
+      std::lock_guard<std::mutex> lock(receiveMutex);
+      phaseFirstSeq = nextSeq;
+      received = 0;
+      latency.Reset();
+   }
+
+   typename Topic::Type sample;
+   PhaseResult result;
+
+   auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rate));
+   auto start = Clock::now();
+   auto end = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(duration));
+   auto next = start;
+   double cpuStart = CpuSeconds();
+
+   while (next < end) {
+      std::this_thread::sleep_until(next);
+      next += interval;
+
+      std::uint64_t seq = nextSeq++;
+      Stamp(sample, seq, payload);
+      sendTimes[seq % sendTimeSlots].store(NowNs(), std::memory_order_relaxed);
+      Topic::Write(pub, sample);
+      result.sent++;
+   }
+
+   result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+   std::this_thread::sleep_for(settings.drain);
+   result.cpuSeconds = CpuSeconds() - cpuStart;
+
+   std::lock_guard<std::mutex> lock(receiveMutex);
+   result.received = received;
+   result.latency.Merge(latency);
+   return result;
+}
+
+/// Writes until the subscriber receives one sample, so discovery is not measured.
+template <typename Topic>
+bool WaitMatched (Manager* pub, const Settings& settings) {
+   typename Topic::Type sample;
+   auto deadline = Clock::now() + settings.matchTimeout;
+
+   while (Clock::now() < deadline) {
+      std::uint64_t seq = nextSeq++;
+      Stamp(sample, seq, 0);
+      Topic::Write(pub, sample);
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      if (lastReceived == seq) return true;
+   }
+   return false;
+}
+
+/// One type at one payload size: a fixed rate phase for latency and CPU, then the rate is
+/// doubled each step for as long as every sample arrives.
+template <typename Topic>
+int RunTopic (Module::Participant& pub, Module::Participant& sub, std::size_t payload, const Settings& settings) {
+   Manager* pubMgr = pub.Get();
+   Manager* subMgr = sub.Get();
+
+   sub.Use([subMgr]() { return Topic::Initialize(subMgr); }, [subMgr]() { Topic::Decommission(subMgr); });
+   pub.Use([pubMgr]() { return Topic::Initialize(pubMgr); }, [pubMgr]() { Topic::Decommission(pubMgr); });
+   Topic::CreateSubscriber(subMgr);
+   Topic::CreatePublisher(pubMgr);
+
+   Metrics::Report report("topics");
+   report
+   .Add("transport", settings.transport)
+   .Add("type", Topic::Name())
+   .Add("payload", static_cast<std::uint64_t>(payload));
+
+   bool matched = WaitMatched<Topic>(pubMgr, settings);
+   report.Add("matched", matched ? 1 : 0);
+
+   if (matched) {
+      PhaseResult fixed = RunPhase<Topic>(pubMgr, payload, settings.rate, settings.duration, settings);
+      report
+      .Add("rate", settings.rate)
+      .Add("sent", fixed.sent)
+      .Add("received", fixed.received)
+      .AddLatency("latency", fixed.latency)
+      .Add("cpu_us_per_msg", fixed.received ? fixed.cpuSeconds * 1e6 / fixed.received : 0.0);
+
+      double sustained = 0.0;
+      for (double rate = settings.rate; settings.stepDuration > 0 && rate <= settings.maxRate; rate *= 2.0) {
+         PhaseResult step = RunPhase<Topic>(pubMgr, payload, rate, settings.stepDuration, settings);
+         double achieved = step.sent / step.seconds;
+         if (step.received < step.sent || achieved < rate * 0.95) break;
+         sustained = achieved;
+      }
+      report.Add("max_sustained_msgs_per_s", sustained);
+   }
+
+   report.Print(std::cout, settings.format);
+
+   pub.Close();
+   sub.Close();
+   return matched ? 0 : 1;
+}
+
+
+using RunFn = int (*)(Module::Participant&, Module::Participant&, std::size_t, const Settings&);
+
+struct Entry {
+   const char* name;
+   RunFn run;
+};
+
+const Entry topics[] = {
+   { "Assessment",               &RunTopic<AssessmentTopic> },
+   { "Command",                  &RunTopic<CommandTopic> },
+   { "EventFragment",            &RunTopic<EventFragmentTopic> },
+   { "EventRecord",              &RunTopic<EventRecordTopic> },
+   { "FragmentAmendmentRequest", &RunTopic<FragmentAmendmentRequestTopic> },
+   { "InstrumentData",           &RunTopic<InstrumentDataTopic> },
+   { "Log",                      &RunTopic<LogTopic> },
+   { "ModuleConfiguration",      &RunTopic<ModuleConfigurationTopic> },
+   { "OmittedEvent",             &RunTopic<OmittedEventTopic> },
+   { "OperationalDescription",   &RunTopic<OperationalDescriptionTopic> },
+   { "PhysiologyModification",   &RunTopic<PhysiologyModificationTopic> },
+   { "PhysiologyValue",          &RunTopic<PhysiologyValueTopic> },
+   { "PhysiologyWaveform",       &RunTopic<PhysiologyWaveformTopic> },
+   { "RenderModification",       &RunTopic<RenderModificationTopic> },
+   { "SimulationControl",        &RunTopic<SimulationControlTopic> },
+   { "Status",                   &RunTopic<StatusTopic> },
+   { "Tick",                     &RunTopic<TickTopic> },
+};
+
+std::vector<std::string> Split (const std::string& list) {
+   std::vector<std::string> items;
+   std::stringstream in(list);
+   std::string item;
+   while (std::getline(in, item, ',')) if (!item.empty()) items.push_back(item);
+   return items;
+}
+
+} // namespace
+
+/// End-to-end latency and throughput for every AMM type.
+///
+/// A publishing and a subscribing Module::Participant run in this process, and each type is
+/// driven through them in turn at every payload size. For each pair the suite reports:
+///
+///   latency      p50/p99/p99.9/max from write to subscriber callback at --rate,
+///                recorded in an HDR histogram
+///   cpu          process CPU per delivered message over that phase (both sides)
+///   throughput   highest rate, doubling from --rate up to --max-rate in --step-duration
+///                phases, at which every sample arrived and the publisher kept pace
+///
+/// --types=Assessment,Tick,...   default all 17
+/// --payloads=64,1024,16384      bytes of text per sample; Tick is fixed size
+/// --step-duration=0             skips the throughput search
+/// --transport=udp|shm|intra     shipped transport profile, default Config.xml
+///
+/// Intra-process delivery is a process-wide setting and a process cannot recreate its
+/// participants, so compare transports with one run each:
+///
+///    for t in udp shm intra; do AMMBenchmarks topics --types=Assessment --transport=$t; done
+int Topics (const Options& opts) {
+   Settings settings;
+   settings.rate = opts.GetDouble("rate", 1000.0);
+   settings.duration = opts.GetDouble("duration", 5.0);
+   settings.stepDuration = opts.GetDouble("step-duration", 1.0);
+   settings.maxRate = opts.GetDouble("max-rate", 256000.0);
+   settings.drain = std::chrono::milliseconds(opts.GetInt("drain-ms", 200));
+   settings.matchTimeout = std::chrono::milliseconds(opts.GetInt("match-timeout-ms", 5000));
+   settings.format = Metrics::ParseFormat(opts.Get("format", "text"));
+
+   Module::Transport transport = Module::Transport::Default;
+   if (Module::ParseTransport(opts.Get("transport", "default"), transport) != 0) {
+      std::cout << "Unknown transport: " << opts.Get("transport", "") << std::endl;
+      return 1;
+   }
+   settings.transport = Module::TransportName(transport);
+
+   std::vector<std::string> types = Split(opts.Get("types", "all"));
+   std::vector<std::string> payloads = Split(opts.Get("payloads", "64,1024,16384"));
+
+   Module::Participant sub(Module::TransportConfig(transport));
+   Module::Participant pub(Module::TransportConfig(transport));
+
+   int failures = 0;
+   for (auto& entry : topics) {
+      bool selected = types.size() == 1 && types[0] == "all";
+      for (auto& type : types) selected = selected || type == entry.name;
+      if (!selected) continue;
+
+      for (auto& payload : payloads) {
+         failures += entry.run(pub, sub, static_cast<std::size_t>(std::atoll(payload.c_str())), settings);
+      }
+   }
+   return failures == 0 ? 0 : 1;
+}
+
+} // namespace Bench
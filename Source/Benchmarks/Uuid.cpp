@@ -0,0 +1,100 @@
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <amm_std.h>
+
+#include "Benchmarks/Bench.h"
+#include "Metrics/Report.h"
+#include "Module/Uuid.h"
+
+namespace Bench {
+
+namespace {
+
+/// Runs op count times and adds its ns and allocations per call to report.
+template <typename Op>
+void Measure (Metrics::Report& report, const std::string& prefix, long long count, Op op) {
+   std::uint64_t allocationsBefore = AllocationCount();
+   double start = WallSeconds();
+   for (long long i = 0; i < count; ++i) op(i);
+   double seconds = WallSeconds() - start;
+   std::uint64_t allocations = AllocationCount() - allocationsBefore;
+
+   report
+   .Add(prefix + "_ns", seconds * 1e9 / count)
+   .Add(prefix + "_allocs", static_cast<double>(allocations) / count);
+}
+
+} // namespace
+
+/// UUID parse, compare and lookup costs, text against binary.
+///
+/// --ids UUIDs are generated and looked up --count times each way, in a rotating order:
+///
+///   parse           AMM::UUID text to Module::Uuid
+///   format          Module::Uuid to text, into a stack buffer
+///   compare_text    AMM::UUID == AMM::UUID, as the tutorials compare Module IDs
+///   compare_binary  Module::Uuid == Module::Uuid
+///   map_text        std::unordered_map<std::string, int> lookup by AMM::UUID
+///   table_text      UuidTable::Find from an AMM::UUID, which includes the parse
+///   table_binary    UuidTable::Find from a Module::Uuid
+int Uuid (const Options& opts) {
+   auto count = opts.GetInt("count", 10000000);
+   auto idCount = static_cast<std::size_t>(opts.GetInt("ids", 64));
+   auto format = Metrics::ParseFormat(opts.Get("format", "text"));
+
+   std::vector<AMM::UUID> text(idCount);
+   std::vector<Module::Uuid> binary(idCount);
+   std::unordered_map<std::string, int> map;
+   Module::UuidTable table(idCount);
+
+   for (std::size_t i = 0; i < idCount; ++i) {
+      binary[i] = Module::Uuid::Generate();
+      text[i] = binary[i].ToAmm();
+      map.emplace(text[i].id(), static_cast<int>(i));
+      table.Intern(binary[i]);
+   }
+
+   /// Copies with their own storage, so text comparisons read two strings.
+   std::vector<AMM::UUID> probes = text;
+
+   long long sink = 0;
+   auto pick = [idCount](long long i) { return static_cast<std::size_t>(i) % idCount; };
+
+   Metrics::Report report("uuid");
+   report.Add("count", static_cast<std::int64_t>(count)).Add("ids", static_cast<std::uint64_t>(idCount));
+
+   Measure(report, "parse", count, [&](long long i) {
+      Module::Uuid parsed;
+      Module::Uuid::Parse(text[pick(i)].id(), parsed);
+      sink += static_cast<long long>(parsed.low);
+   });
+   Measure(report, "format", count, [&](long long i) {
+      char buffer[37];
+      binary[pick(i)].Format(buffer);
+      sink += buffer[35];
+   });
+   Measure(report, "compare_text", count, [&](long long i) {
+      sink += probes[pick(i)].id() == text[pick(i * 7 + 1)].id();
+   });
+   Measure(report, "compare_binary", count, [&](long long i) {
+      sink += binary[pick(i)] == binary[pick(i * 7 + 1)];
+   });
+   Measure(report, "map_text", count, [&](long long i) {
+      sink += map.find(probes[pick(i)].id())->second;
+   });
+   Measure(report, "table_text", count, [&](long long i) {
+      sink += table.Find(probes[pick(i)]);
+   });
+   Measure(report, "table_binary", count, [&](long long i) {
+      sink += table.Find(binary[pick(i)]);
+   });
+
+   report.Print(std::cout, format);
+   if (sink == 42) std::cout << std::endl;
+   return 0;
+}
+
+} // namespace Bench
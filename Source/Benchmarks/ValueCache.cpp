@@ -0,0 +1,139 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Benchmarks/Bench.h"
+#include "Metrics/Histogram.h"
+#include "Metrics/Report.h"
+#include "Module/ValueCache.h"
+
+namespace Bench {
+
+namespace {
+
+/// The map and lock each module used to write for itself.
+class MapCache {
+public:
+   void Update (const AMM::PhysiologyValue& sample) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_values[sample.name()] = sample.value();
+   }
+
+   double Get (const std::string& name) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_values[name];
+   }
+
+private:
+   std::mutex m_mutex;
+   std::unordered_map<std::string, double> m_values;
+};
+
+} // namespace
+
+/// Physiology Value last-value cache.
+///
+/// --writers threads stand in for listener threads and update --names values as fast as they
+/// can. Meanwhile a reader thread looks up --lookups of them per simulated Tick. Reports
+/// updates per second and lookup latency, averaged over each batch of lookups since a single
+/// lookup is shorter than the clock's resolution.
+///
+/// --mode=cache uses Module::ValueCache with IDs resolved up front.
+/// --mode=snapshot reads the same IDs with ValueCache::Snapshot, as of one moment, and also
+/// reports how many snapshots came back partial because updates kept overtaking them.
+/// --mode=map uses a mutex-guarded std::unordered_map keyed by name.
+int ValueCache (const Options& opts) {
+   std::string mode = opts.Get("mode", "cache");
+   auto writers = opts.GetInt("writers", 2);
+   auto names = opts.GetInt("names", 200);
+   auto lookups = opts.GetInt("lookups", 16);
+   double duration = opts.GetDouble("duration", 3.0);
+   auto format = Metrics::ParseFormat(opts.Get("format", "text"));
+
+   using Clock = std::chrono::steady_clock;
+
+   std::vector<AMM::PhysiologyValue> samples(static_cast<std::size_t>(names));
+   for (long long i = 0; i < names; ++i) {
+      samples[static_cast<std::size_t>(i)].name("Physiology_Value_" + std::to_string(i));
+   }
+
+   Module::ValueCache cache(static_cast<std::size_t>(names));
+   MapCache map;
+
+   std::vector<Module::ValueCache::Id> ids;
+   std::vector<std::string> lookupNames;
+   for (long long i = 0; i < lookups; ++i) {
+      auto& name = samples[static_cast<std::size_t>(i % names)].name();
+      ids.push_back(cache.Intern(name));
+      lookupNames.push_back(name);
+   }
+   std::vector<Module::ValueCache::Value> values(ids.size());
+
+   std::atomic<bool> stop(false);
+   std::atomic<std::uint64_t> updates(0);
+   std::vector<std::thread> threads;
+
+   for (long long w = 0; w < writers; ++w) {
+      threads.emplace_back([&, w]() {
+         AMM::PhysiologyValue sample;
+         std::uint64_t count = 0;
+         for (std::size_t i = static_cast<std::size_t>(w); !stop; i = (i + 1) % samples.size()) {
+            sample = samples[i];
+            sample.value(static_cast<double>(count));
+            if (mode == "map") map.Update(sample);
+            else cache.Update(sample);
+            count++;
+         }
+         updates += count;
+      });
+   }
+
+   Metrics::Histogram lookupTime;
+   std::uint64_t snapshots = 0;
+   std::uint64_t partial = 0;
+   double sink = 0.0;
+   auto end = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(duration));
+
+   while (Clock::now() < end) {
+      auto before = Clock::now();
+      if (mode == "map") {
+         for (auto& name : lookupNames) sink += map.Get(name);
+      } else if (mode == "snapshot") {
+         snapshots++;
+         if (!cache.Snapshot(ids.data(), ids.size(), values.data())) partial++;
+         for (auto& value : values) sink += value.value;
+      } else {
+         cache.Get(ids.data(), ids.size(), values.data());
+         for (auto& value : values) sink += value.value;
+      }
+      auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - before).count();
+      lookupTime.Record(static_cast<std::uint64_t>(elapsed / lookups));
+   }
+
+   stop = true;
+   for (auto& thread : threads) thread.join();
+
+   Metrics::Report report("value_cache");
+   report
+   .Add("mode", mode)
+   .Add("writers", static_cast<std::int64_t>(writers))
+   .Add("names", static_cast<std::int64_t>(names))
+   .Add("updates_per_s", updates / duration)
+   .AddLatency("lookup", lookupTime);
+   if (mode == "snapshot") {
+      report
+      .Add("snapshots", snapshots)
+      .Add("snapshot_partial", partial);
+   }
+   report
+   .Add("checksum", sink != 0.0 ? 1 : 0);
+   report.Print(std::cout, format);
+   return 0;
+}
+
+} // namespace Bench
@@ -0,0 +1,158 @@
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <amm_std.h>
+
+#include "Benchmarks/Bench.h"
+#include "Metrics/Report.h"
+#include "Module/Participant.h"
+#include "Module/RunLoop.h"
+#include "Module/Waveform.h"
+
+namespace Bench {
+
+namespace {
+
+std::atomic<std::uint64_t> pointsReceived(0);
+
+void OnPhysiologyWaveform (AMM::PhysiologyWaveform& waveform, eprosima::fastrtps::SampleInfo_t* info) {
+   pointsReceived++;
+}
+
+Module::WaveformAssembler assembler(nullptr);
+
+void OnInstrumentData (AMM::InstrumentData& data, eprosima::fastrtps::SampleInfo_t* info) {
+   assembler.OnInstrumentData(data);
+}
+
+long long Timestamp () {
+   using namespace std::chrono;
+   return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+/// Chunked vs per-point waveform publishing.
+///
+/// A publishing and a subscribing Module::Participant run in this process. A producer thread
+/// generates --channels waveforms at --rate points per second each for --duration seconds.
+///
+/// --mode=point writes one Physiology Waveform per point.
+/// --mode=chunked pushes points into a Module::WaveformPublisher per channel, which writes
+/// Instrument Data chunks of --chunk points or every --max-latency-ms.
+///
+/// Reports DDS writes, points delivered and lost, and process CPU per point.
+int Waveform (const Options& opts) {
+   std::string mode = opts.Get("mode", "chunked");
+   auto channels = opts.GetInt("channels", 4);
+   double rate = opts.GetDouble("rate", 500.0);
+   double duration = opts.GetDouble("duration", 5.0);
+   auto chunk = opts.GetInt("chunk", 50);
+   auto maxLatencyMs = opts.GetInt("max-latency-ms", 100);
+   auto format = Metrics::ParseFormat(opts.Get("format", "text"));
+
+   using Clock = std::chrono::steady_clock;
+
+   Module::Participant sub("Config/Config.xml");
+   Module::Participant pub("Config/Config.xml");
+   bool chunked = mode == "chunked";
+
+   if (chunked) {
+      sub->InitializeInstrumentData();
+      sub->CreateInstrumentDataSubscriber(&OnInstrumentData);
+      pub->InitializeInstrumentData();
+      pub->CreateInstrumentDataPublisher();
+   } else {
+      sub->InitializePhysiologyWaveform();
+      sub->CreatePhysiologyWaveformSubscriber(&OnPhysiologyWaveform);
+      pub->InitializePhysiologyWaveform();
+      pub->CreatePhysiologyWaveformPublisher();
+   }
+
+   /// Let discovery finish so startup losses do not count against either mode.
+   std::this_thread::sleep_for(std::chrono::milliseconds(opts.GetInt("warmup-ms", 1000)));
+
+   Module::RunLoop loop;
+   std::atomic<std::uint64_t> writes(0);
+
+   Module::WaveformPublisher::Options chunkOptions;
+   chunkOptions.chunkSize = static_cast<std::size_t>(chunk);
+   chunkOptions.maxLatency = std::chrono::milliseconds(maxLatencyMs);
+
+   std::deque<Module::WaveformPublisher> publishers;
+   std::vector<AMM::PhysiologyWaveform> samples(static_cast<std::size_t>(channels));
+   for (long long c = 0; c < channels; ++c) {
+      std::string name = "Waveform_" + std::to_string(c);
+      samples[static_cast<std::size_t>(c)].name(name);
+      if (chunked) {
+         publishers.emplace_back(loop, name, [&](AMM::InstrumentData& data) {
+            writes++;
+            return pub->WriteInstrumentData(data);
+         }, chunkOptions);
+      }
+   }
+
+   std::thread t([&]() { loop.Run(); });
+
+   auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rate));
+   auto start = Clock::now();
+   auto end = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(duration));
+   double cpuStart = CpuSeconds();
+   std::uint64_t pointsSent = 0;
+
+   for (auto next = start; next < end; next += interval) {
+      std::this_thread::sleep_until(next);
+      long long timestamp = Timestamp();
+      double value = static_cast<double>(pointsSent % 1000);
+
+      for (long long c = 0; c < channels; ++c) {
+         if (chunked) {
+            publishers[static_cast<std::size_t>(c)].Push(value, timestamp);
+         } else {
+            auto& sample = samples[static_cast<std::size_t>(c)];
+            sample.timestamp(timestamp);
+            sample.value(value);
+            pub->WritePhysiologyWaveform(sample);
+            writes++;
+         }
+         pointsSent++;
+      }
+   }
+
+   loop.Stop();
+   t.join();
+   for (auto& publisher : publishers) publisher.Flush();
+
+   std::this_thread::sleep_for(std::chrono::milliseconds(500));
+   double cpu = CpuSeconds() - cpuStart;
+
+   std::uint64_t received = chunked ? assembler.GetStats().points : pointsReceived.load();
+
+   Metrics::Report report("waveform");
+   report
+   .Add("mode", mode)
+   .Add("channels", static_cast<std::int64_t>(channels))
+   .Add("rate", rate)
+   .Add("points_sent", pointsSent)
+   .Add("points_received", received)
+   .Add("writes", writes.load())
+   .Add("writes_per_s", writes / duration)
+   .Add("cpu_us_per_point", pointsSent ? cpu * 1e6 / pointsSent : 0.0);
+
+   if (chunked) {
+      auto stats = assembler.GetStats();
+      report
+      .Add("lost_chunks", stats.lostChunks)
+      .Add("lost_points", stats.lostPoints)
+      .Add("streams", stats.streams);
+   }
+   report.Print(std::cout, format);
+   return 0;
+}
+
+} // namespace Bench
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmarks/Bench.h"
+#include "Metrics/Report.h"
+#include "Module/WorkerPool.h"
+
+namespace Bench {
+
+namespace {
+
+using Clock = Module::WorkerPool::Clock;
+
+void Work (double micros) {
+   auto until = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double, std::micro>(micros));
+   while (Clock::now() < until) {}
+}
+
+struct Topic {
+   Module::WorkerPool::Strand* strand;
+   double workUs;
+
+   /// Written only by tasks on this topic's strand, which never run concurrently.
+   long long lastSeq = -1;
+   long long outOfOrder = 0;
+};
+
+} // namespace
+
+/// Callback worker pool scaling and ordering.
+///
+/// For each thread count in --threads (default 1,2,4 and one per core), a producer posts
+/// --tasks tasks round robin across --topics strands, each busy-waiting --work-us. The first
+/// topic is the expensive one, at --heavy-us per task, like Module Configuration parsing.
+/// Every task checks it ran after the one posted before it on its strand.
+///
+/// Reports wall time, tasks per second and speedup over the first thread count, steals,
+/// peak queue depth, mean task time on the heavy and light topics, and any ordering
+/// violations, which must be 0.
+int WorkerPool (const Options& opts) {
+   auto topicCount = opts.GetInt("topics", 8);
+   auto tasks = opts.GetInt("tasks", 20000);
+   double workUs = opts.GetDouble("work-us", 20.0);
+   double heavyUs = opts.GetDouble("heavy-us", 200.0);
+   auto format = Metrics::ParseFormat(opts.Get("format", "text"));
+
+   std::string cores = std::to_string(std::max(1u, std::thread::hardware_concurrency()));
+   std::stringstream threadList(opts.Get("threads", "1,2,4," + cores));
+
+   double baseline = 0.0;
+   std::string item;
+   while (std::getline(threadList, item, ',')) {
+      auto threads = static_cast<std::size_t>(std::atoll(item.c_str()));
+      if (threads == 0) continue;
+
+      std::vector<Topic> topics(static_cast<std::size_t>(topicCount));
+      double seconds = 0.0;
+      Module::WorkerPool::Stats stats;
+      {
+         Module::WorkerPool pool(threads);
+         for (std::size_t i = 0; i < topics.size(); ++i) {
+            topics[i].strand = &pool.MakeStrand("topic" + std::to_string(i));
+            topics[i].workUs = i == 0 ? heavyUs : workUs;
+         }
+
+         std::atomic<long long> done(0);
+         double start = WallSeconds();
+         for (long long i = 0; i < tasks; ++i) {
+            Topic& topic = topics[static_cast<std::size_t>(i % topicCount)];
+            long long seq = i / topicCount;
+            pool.Post(*topic.strand, [&topic, &done, seq]() {
+               if (seq != topic.lastSeq + 1) topic.outOfOrder++;
+               topic.lastSeq = seq;
+               Work(topic.workUs);
+               done++;
+            });
+         }
+         while (done < tasks) std::this_thread::sleep_for(std::chrono::microseconds(100));
+         seconds = WallSeconds() - start;
+         stats = pool.GetStats();
+      }
+
+      long long outOfOrder = 0;
+      for (auto& topic : topics) outOfOrder += topic.outOfOrder;
+
+      double rate = tasks / seconds;
+      if (baseline == 0.0) baseline = rate;
+
+      auto meanUs = [](const Module::WorkerPool::StrandStats& s) {
+         return s.executed ? Micros(s.total) / s.executed : 0.0;
+      };
+      std::size_t maxDepth = 0;
+      double lightUs = 0.0;
+      for (std::size_t i = 0; i < stats.strands.size(); ++i) {
+         maxDepth = std::max(maxDepth, stats.strands[i].maxDepth);
+         if (i > 0) lightUs += meanUs(stats.strands[i]) / (stats.strands.size() - 1);
+      }
+
+      Metrics::Report report("worker_pool");
+      report
+      .Add("threads", static_cast<std::uint64_t>(threads))
+      .Add("topics", static_cast<std::int64_t>(topicCount))
+      .Add("tasks", static_cast<std::int64_t>(tasks))
+      .Add("wall_s", seconds)
+      .Add("tasks_per_s", rate)
+      .Add("speedup", rate / baseline)
+      .Add("steals", stats.steals)
+      .Add("max_depth", static_cast<std::uint64_t>(maxDepth))
+      .Add("heavy_task_us", stats.strands.empty() ? 0.0 : meanUs(stats.strands[0]))
+      .Add("light_task_us", lightUs)
+      .Add("out_of_order", static_cast<std::int64_t>(outOfOrder));
+      report.Print(std::cout, format);
+   }
+   return 0;
+}
+
+} // namespace Bench
@@ -0,0 +1,64 @@
+#include <iostream>
+#include <string>
+
+#include <amm_std.h>
+
+#include "Benchmarks/Bench.h"
+#include "Metrics/Report.h"
+#include "Module/DdsError.h"
+#include "Module/Participant.h"
+
+namespace Bench {
+
+/// Cost of error reporting on successful writes.
+///
+/// Writes --count Assessments on one participant and reports heap allocations and time per
+/// write. The Assessment is built once, so everything counted comes from the write and its
+/// error reporting.
+///
+/// --mode=errmsg uses the errmsg overload with a fresh string per write, as in Tutorial 5.
+/// --mode=code uses the plain overload and wraps the result in a Module::DdsResult.
+int WriteErrors (const Options& opts) {
+   std::string mode = opts.Get("mode", "code");
+   auto count = opts.GetInt("count", 100000);
+   auto format = Metrics::ParseFormat(opts.Get("format", "text"));
+
+   Module::Participant participant("Config/Config.xml");
+   auto* mgr = participant.Get();
+   participant.Use([mgr]() { return mgr->InitializeAssessment(); }, [mgr]() { mgr->DecommissionAssessment(); });
+   mgr->CreateAssessmentPublisher();
+
+   AMM::Assessment assessment;
+   assessment.comment("write errors benchmark");
+
+   std::uint64_t failures = 0;
+   std::uint64_t allocationsBefore = AllocationCount();
+   double start = WallSeconds();
+
+   for (long long i = 0; i < count; ++i) {
+      if (mode == "errmsg") {
+         std::string errmsg;
+         if (mgr->WriteAssessment(errmsg, assessment) != 0) failures++;
+      } else {
+         Module::DdsResult result(mgr->WriteAssessment(assessment), "WriteAssessment");
+         if (!result.Ok()) failures++;
+      }
+   }
+
+   double seconds = WallSeconds() - start;
+   std::uint64_t allocations = AllocationCount() - allocationsBefore;
+
+   participant.Close();
+
+   Metrics::Report report("write_errors");
+   report
+   .Add("mode", mode)
+   .Add("count", static_cast<std::int64_t>(count))
+   .Add("failures", failures)
+   .Add("allocs_per_write", static_cast<double>(allocations) / count)
+   .Add("ns_per_write", seconds * 1e9 / count);
+   report.Print(std::cout, format);
+   return 0;
+}
+
+} // namespace Bench
@@ -18,7 +18,13 @@ namespace T5 { void Tutorial_5 (); }
 namespace T6 { void Tutorial_6 (); }
 namespace T7 { void Tutorial_7 (); }
 
-int main () {
+namespace Headless { int Run (int argc, char* argv[]); }
+
+int main (int argc, char* argv[]) {
+
+   /// Any command line arguments select the headless, scriptable mode.
+   /// Run with --help for the list of scenarios and options.
+   if (argc > 1) return Headless::Run(argc, argv);
 
    /// BUG:
    /// There is currently a known issue where publishers and subscribers fail
@@ -30,6 +36,10 @@ int main () {
    ///
    /// RECOMMENDATION: Restart the program between each tutorial and only use Shutdown
    /// in custom modules if the program is planning to exit.
+   ///
+   /// Modules that need to change scenarios without restarting can keep a single
+   /// Module::Participant for the life of the process and close its session instead,
+   /// which decommissions every type but leaves the participant running.
 
    for (;;) {
 
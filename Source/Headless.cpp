@@ -0,0 +1,302 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/// In order to use the AMM Library, this header must be included.
+#include <amm_std.h>
+
+#include "Metrics/Histogram.h"
+#include "Metrics/Report.h"
+#include "Module/Logger.h"
+#include "Module/Transport.h"
+
+namespace T7 {
+void RunModule (const std::string& configPath, const std::function<void()>& waitForExit);
+void ReportStats (Metrics::Report& report);
+}
+
+/// Headless entry point.
+///
+/// Runs one scenario without the interactive menu and prints its results in a machine readable
+/// format, so runs can be scripted and repeated. Because of the Shutdown issue described in
+/// ExampleModule.cpp, each run is a fresh process.
+///
+///   AMMExampleModule --scenario=publisher --duration=10 --rate=1000 --payload=256 --format=json
+///
+/// Publisher and subscriber exchange Assessment samples. The comment field carries a sequence
+/// number, the send time and padding up to the payload size. Send times come from the steady
+/// clock, which is shared by every process on one machine, so publisher and subscriber must run
+/// on the same host for latency figures to mean anything.
+namespace Headless {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Settings {
+   std::string scenario = "loopback";
+   std::string config = Module::TransportConfigFromEnvironment();
+   double duration = 10.0;
+   double rate = 1000.0;
+   std::size_t payload = 64;
+   double warmup = 0.5;
+   Metrics::Format format = Metrics::Format::Text;
+};
+
+std::uint64_t NowNs () {
+   return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count()
+   );
+}
+
+double Seconds (Clock::duration d) {
+   return std::chrono::duration<double>(d).count();
+}
+
+void Usage () {
+   std::cout
+   << " Usage: AMMExampleModule [--scenario=NAME] [--key=value ...]\n"
+   << "\n"
+   << " Without arguments, the interactive tutorial menu runs.\n"
+   << "\n"
+   << " Scenarios:\n"
+   << "   publisher    Publish Assessment at --rate for --duration\n"
+   << "   subscriber   Receive Assessment for --duration and report latency\n"
+   << "   loopback     publisher and subscriber in this process (default)\n"
+   << "   compliant    Run the Tutorial 7 module for --duration\n"
+   << "\n"
+   << " Options:\n"
+   << "   --duration=SECONDS    default 10\n"
+   << "   --rate=PER_SECOND     default 1000\n"
+   << "   --payload=BYTES       default 64\n"
+   << "   --warmup=SECONDS      wait after creating publishers, default 0.5\n"
+   << "   --format=text|json|csv\n"
+   << "   --config=PATH         default Config/Config.xml, or the AMM_TRANSPORT profile\n"
+   << "   --transport=NAME      udp, shm or intra: use that shipped profile instead of --config\n";
+}
+
+int Parse (int argc, char* argv[], Settings& settings) {
+   for (int i = 1; i < argc; ++i) {
+      std::string arg = argv[i];
+      if (arg == "--help" || arg == "-h") return 1;
+
+      auto eq = arg.find('=');
+      if (arg.compare(0, 2, "--") != 0 || eq == std::string::npos) {
+         std::cout << "Invalid argument: " << arg << "\n\n";
+         return 1;
+      }
+
+      std::string key = arg.substr(2, eq - 2);
+      std::string value = arg.substr(eq + 1);
+
+      if      (key == "scenario") settings.scenario = value;
+      else if (key == "config")   settings.config = value;
+      else if (key == "duration") settings.duration = std::atof(value.c_str());
+      else if (key == "rate") {
+         /// atof gives 0 for text that is not a number, so this also rejects those.
+         settings.rate = std::atof(value.c_str());
+         if (!(settings.rate > 0)) {
+            std::cout << "Invalid rate: " << value << " (must be greater than 0)\n\n";
+            return 1;
+         }
+      }
+      else if (key == "payload")  settings.payload = static_cast<std::size_t>(std::atoll(value.c_str()));
+      else if (key == "warmup")   settings.warmup = std::atof(value.c_str());
+      else if (key == "format")   settings.format = Metrics::ParseFormat(value);
+      else if (key == "transport") {
+         Module::Transport transport;
+         if (Module::ParseTransport(value, transport) != 0) {
+            std::cout << "Unknown transport: " << value << "\n\n";
+            return 1;
+         }
+         settings.config = Module::TransportConfig(transport);
+      }
+      else {
+         std::cout << "Unknown option: " << key << "\n\n";
+         return 1;
+      }
+   }
+   return 0;
+}
+
+
+/// Receiving side. Callbacks can arrive on more than one listener thread.
+std::mutex receiveMutex;
+Metrics::Histogram receiveLatency;
+std::uint64_t received = 0;
+std::uint64_t highestSeq = 0;
+std::uint64_t payloadBytes = 0;
+
+void OnAssessment (AMM::Assessment& assessment, eprosima::fastrtps::SampleInfo_t* info) {
+   std::uint64_t now = NowNs();
+   const std::string& comment = assessment.comment();
+
+   char* end = nullptr;
+   std::uint64_t seq = std::strtoull(comment.c_str(), &end, 10);
+   std::uint64_t sent = std::strtoull(end, nullptr, 10);
+
+   std::lock_guard<std::mutex> lock(receiveMutex);
+   received++;
+   payloadBytes += comment.size();
+   if (seq > highestSeq) highestSeq = seq;
+   if (sent != 0 && now >= sent) receiveLatency.Record(now - sent);
+}
+
+void AddReceiveResults (Metrics::Report& report, double seconds) {
+   std::lock_guard<std::mutex> lock(receiveMutex);
+   report
+   .Add("received", received)
+   .Add("lost", highestSeq >= received ? highestSeq - received : 0)
+   .Add("recv_msgs_per_s", received / seconds)
+   .Add("recv_mb_per_s", payloadBytes / seconds / 1e6)
+   .AddLatency("latency", receiveLatency);
+}
+
+
+/// Sending side. Publishes numbered Assessments on a fixed schedule.
+void Publish (AMM::DDSManager<void>* mgr, const Settings& settings, Metrics::Report& report) {
+   AMM::Assessment assessment;
+   assessment.value(AMM::AssessmentValue::SUCCESS);
+
+   std::string comment;
+   Metrics::Histogram writeTime;
+   auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / settings.rate));
+
+   std::uint64_t sent = 0;
+   std::uint64_t failed = 0;
+   auto start = Clock::now();
+   auto end = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(settings.duration));
+   auto next = start;
+
+   while (next < end) {
+      std::this_thread::sleep_until(next);
+      next += interval;
+
+      /// Sequence numbers start at 1 so a subscriber can tell them from a parse failure.
+      comment = std::to_string(++sent) + " " + std::to_string(NowNs()) + " ";
+      if (comment.size() < settings.payload) comment.append(settings.payload - comment.size(), 'x');
+      assessment.comment(comment);
+
+      auto before = Clock::now();
+      if (mgr->WriteAssessment(assessment) != 0) failed++;
+      writeTime.Record(static_cast<std::uint64_t>(
+         std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - before).count()
+      ));
+   }
+
+   double seconds = Seconds(Clock::now() - start);
+   report
+   .Add("sent", sent)
+   .Add("write_failures", failed)
+   .Add("send_msgs_per_s", sent / seconds)
+   .Add("send_mb_per_s", sent * static_cast<double>(settings.payload) / seconds / 1e6)
+   .AddLatency("write", writeTime);
+}
+
+void Warmup (const Settings& settings) {
+   std::this_thread::sleep_for(std::chrono::duration<double>(settings.warmup));
+}
+
+void AddSettings (Metrics::Report& report, const Settings& settings) {
+   report
+   .Add("duration_s", settings.duration)
+   .Add("rate", settings.rate)
+   .Add("payload", static_cast<std::uint64_t>(settings.payload));
+}
+
+
+int RunPublisher (const Settings& settings, Metrics::Report& report) {
+   AMM::DDSManager<void>* mgr = new AMM::DDSManager<void>(settings.config);
+   mgr->InitializeAssessment();
+   mgr->CreateAssessmentPublisher();
+   Warmup(settings);
+
+   Publish(mgr, settings, report);
+
+   mgr->Shutdown();
+   delete mgr;
+   return 0;
+}
+
+int RunSubscriber (const Settings& settings, Metrics::Report& report) {
+   AMM::DDSManager<void>* mgr = new AMM::DDSManager<void>(settings.config);
+   mgr->InitializeAssessment();
+   mgr->CreateAssessmentSubscriber(&OnAssessment);
+
+   std::this_thread::sleep_for(std::chrono::duration<double>(settings.duration));
+   AddReceiveResults(report, settings.duration);
+
+   mgr->Shutdown();
+   delete mgr;
+   return 0;
+}
+
+int RunLoopback (const Settings& settings, Metrics::Report& report) {
+   AMM::DDSManager<void>* sub = new AMM::DDSManager<void>(settings.config);
+   sub->InitializeAssessment();
+   sub->CreateAssessmentSubscriber(&OnAssessment);
+
+   AMM::DDSManager<void>* pub = new AMM::DDSManager<void>(settings.config);
+   pub->InitializeAssessment();
+   pub->CreateAssessmentPublisher();
+   Warmup(settings);
+
+   auto start = Clock::now();
+   Publish(pub, settings, report);
+
+   /// Give the last samples time to arrive.
+   std::this_thread::sleep_for(std::chrono::milliseconds(200));
+   AddReceiveResults(report, Seconds(Clock::now() - start));
+
+   pub->Shutdown();
+   sub->Shutdown();
+   delete pub;
+   delete sub;
+   return 0;
+}
+
+int RunCompliant (const Settings& settings, Metrics::Report& report) {
+   T7::RunModule(settings.config, [&]() {
+      std::this_thread::sleep_for(std::chrono::duration<double>(settings.duration));
+      T7::ReportStats(report);
+   });
+   return 0;
+}
+
+} // namespace
+
+int Run (int argc, char* argv[]) {
+   /// Keep standard output for the report, so json and csv output stay parseable
+   /// while the compliant scenario's module logs.
+   Module::Log().ConsoleTo(stderr);
+
+   Settings settings;
+   if (Parse(argc, argv, settings) != 0) {
+      Usage();
+      return 1;
+   }
+
+   Metrics::Report report(settings.scenario);
+   AddSettings(report, settings);
+
+   int result;
+   if      (settings.scenario == "publisher")  result = RunPublisher(settings, report);
+   else if (settings.scenario == "subscriber") result = RunSubscriber(settings, report);
+   else if (settings.scenario == "loopback")   result = RunLoopback(settings, report);
+   else if (settings.scenario == "compliant")  result = RunCompliant(settings, report);
+   else {
+      std::cout << "Unknown scenario: " << settings.scenario << "\n\n";
+      Usage();
+      return 1;
+   }
+
+   report.Print(std::cout, settings.format);
+   return result;
+}
+
+} // namespace Headless
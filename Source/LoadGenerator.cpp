@@ -0,0 +1,355 @@
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// In order to use the AMM Library, this header must be included.
+#include <amm_std.h>
+
+#include "Metrics/Histogram.h"
+#include "Metrics/Options.h"
+#include "Metrics/Report.h"
+#include "Module/RunLoop.h"
+#include "Module/Transport.h"
+
+/// Synthetic Sim Manager.
+///
+/// Stands in for Sim Manager and a Command Line Module so a module can be put under load on
+/// one machine. It publishes Tick at a fixed rate, sends Simulation Control on a schedule and
+/// bursts of Module Configuration, and times the responses of every module it discovers
+/// through Operational Description:
+///
+///   SAVE                  -> the module publishes its Module Configuration
+///   Module Configuration  -> the module publishes its Status
+///
+/// Run the module under test next to it, e.g. AMMExampleModule --scenario=compliant, which
+/// reports the Tick gaps and queue depth seen from the module's side.
+///
+///   AMMLoadGenerator --tick-hz=1000 --duration=30 --controls=RUN,HALT,RUN,SAVE,RESET
+namespace LoadGen {
+
+using Clock = std::chrono::steady_clock;
+
+const std::string generatorName = "AMM Load Generator";
+
+struct Settings {
+   double duration;
+   double tickHz;
+   double warmup;
+   double controlPeriod;
+   double stormPeriod;
+   long long stormSize;
+   double stormForeign;
+   std::vector<AMM::ControlType> controls;
+   Metrics::Format format;
+};
+
+AMM::DDSManager<void>* mgr;
+
+/// Requests waiting for a response, by module ID, oldest first.
+using Pending = std::map<std::string, std::deque<Clock::time_point>>;
+
+std::mutex responseMutex;
+std::set<std::string> modules;
+Pending pendingSaves;
+Pending pendingConfigs;
+Metrics::Histogram saveResponse;
+Metrics::Histogram configResponse;
+std::uint64_t saveRequests = 0;
+std::uint64_t configRequests = 0;
+std::uint64_t foreignConfigs = 0;
+
+/// Requests older than this many per module are counted as unanswered and dropped.
+const std::size_t maxPending = 4096;
+
+void Answer (Pending& pending, const std::string& moduleId, Metrics::Histogram& histogram) {
+   auto it = pending.find(moduleId);
+   if (it == pending.end() || it->second.empty()) return;
+
+   histogram.Record(static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - it->second.front()).count()
+   ));
+   it->second.pop_front();
+}
+
+void Ask (Pending& pending, const std::string& moduleId) {
+   auto& queue = pending[moduleId];
+   if (queue.size() >= maxPending) queue.pop_front();
+   queue.push_back(Clock::now());
+}
+
+std::uint64_t Unanswered (const Pending& pending) {
+   std::uint64_t count = 0;
+   for (auto& entry : pending) count += entry.second.size();
+   return count;
+}
+
+void OnOperationalDescription (AMM::OperationalDescription& od, eprosima::fastrtps::SampleInfo_t* info) {
+   std::lock_guard<std::mutex> lock(responseMutex);
+   if (modules.insert(od.module_id().id()).second) {
+      std::cout << "Discovered module " << od.name() << " " << od.module_id().id() << std::endl;
+   }
+}
+
+void OnModuleConfiguration (AMM::ModuleConfiguration& mc, eprosima::fastrtps::SampleInfo_t* info) {
+   /// This participant also receives its own storms.
+   if (mc.name() == generatorName) return;
+
+   std::lock_guard<std::mutex> lock(responseMutex);
+   Answer(pendingSaves, mc.module_id().id(), saveResponse);
+}
+
+void OnStatus (AMM::Status& status, eprosima::fastrtps::SampleInfo_t* info) {
+   std::lock_guard<std::mutex> lock(responseMutex);
+   Answer(pendingConfigs, status.module_id().id(), configResponse);
+}
+
+
+long long Timestamp () {
+   using namespace std::chrono;
+   return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+void SendControl (AMM::ControlType type) {
+   AMM::SimulationControl simControl;
+   simControl.timestamp(Timestamp());
+   simControl.type(type);
+   mgr->WriteSimulationControl(simControl);
+
+   if (type == AMM::ControlType::SAVE) {
+      std::lock_guard<std::mutex> lock(responseMutex);
+      for (auto& id : modules) {
+         Ask(pendingSaves, id);
+         saveRequests++;
+      }
+   }
+}
+
+/// Sends stormSize Module Configurations back to back. Most go round robin to discovered
+/// modules, the stormForeign fraction to IDs no module has, which modules must ignore.
+void SendStorm (const Settings& settings) {
+   std::vector<std::string> targets;
+   {
+      std::lock_guard<std::mutex> lock(responseMutex);
+      targets.assign(modules.begin(), modules.end());
+   }
+
+   AMM::ModuleConfiguration mc;
+   mc.name(generatorName);
+
+   double foreign = 0.0;
+   for (long long i = 0; i < settings.stormSize; ++i) {
+      foreign += settings.stormForeign;
+      bool toForeign = targets.empty() || foreign >= 1.0;
+      if (toForeign) foreign -= 1.0;
+
+      AMM::UUID id;
+      id.id(toForeign ? AMM::DDSManager<void>::GenerateUuidString() : targets[i % targets.size()]);
+      mc.module_id(id);
+      mc.timestamp(Timestamp());
+
+      if (!toForeign) {
+         std::lock_guard<std::mutex> lock(responseMutex);
+         Ask(pendingConfigs, id.id());
+         configRequests++;
+      } else {
+         foreignConfigs++;
+      }
+      mgr->WriteModuleConfiguration(mc);
+   }
+}
+
+/// Publishes Tick on a fixed schedule until stop is set. Records how late each write was.
+void SendTicks (const Settings& settings, const std::atomic<bool>& stop,
+                std::uint64_t& sent, Metrics::Histogram& lateness) {
+   auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / settings.tickHz));
+   auto next = Clock::now();
+
+   AMM::Tick tick;
+   tick.time_dilation(1.0f);
+
+   while (!stop) {
+      std::this_thread::sleep_until(next);
+
+      tick.frame(static_cast<long long>(++sent));
+      mgr->WriteTick(tick);
+
+      lateness.Record(static_cast<std::uint64_t>(
+         std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - next).count()
+      ));
+      next += interval;
+   }
+}
+
+
+int ParseControls (const std::string& list, std::vector<AMM::ControlType>& controls) {
+   std::stringstream in(list);
+   std::string name;
+   while (std::getline(in, name, ',')) {
+      if      (name == "RUN")   controls.push_back(AMM::ControlType::RUN);
+      else if (name == "HALT")  controls.push_back(AMM::ControlType::HALT);
+      else if (name == "RESET") controls.push_back(AMM::ControlType::RESET);
+      else if (name == "SAVE")  controls.push_back(AMM::ControlType::SAVE);
+      else {
+         std::cout << "Unknown control: " << name << std::endl;
+         return 1;
+      }
+   }
+   return 0;
+}
+
+int Run (const Metrics::Options& opts) {
+   Settings settings;
+   settings.duration = opts.GetDouble("duration", 30.0);
+   settings.tickHz = opts.GetDouble("tick-hz", 50.0);
+   settings.warmup = opts.GetDouble("warmup", 2.0);
+   settings.controlPeriod = opts.GetDouble("control-period", 2.0);
+   settings.stormPeriod = opts.GetDouble("storm-period", 5.0);
+   settings.stormSize = opts.GetInt("storm-size", 50);
+   settings.stormForeign = opts.GetDouble("storm-foreign", 0.5);
+   settings.format = Metrics::ParseFormat(opts.Get("format", "text"));
+
+   if (ParseControls(opts.Get("controls", "RUN,HALT,RUN,SAVE,RESET,RUN"), settings.controls) != 0) return 1;
+
+   if (!(settings.tickHz > 0)) {
+      std::cout << "Invalid --tick-hz: must be greater than 0." << std::endl;
+      return 1;
+   }
+   if (settings.tickHz < 50.0 || settings.tickHz > 10000.0) {
+      std::cout << "Warning: --tick-hz outside the 50 Hz to 10 kHz Sim Manager range." << std::endl;
+   }
+
+   std::string config = opts.Get("config", "Config/Config.xml");
+   if (opts.Has("transport")) {
+      Module::Transport transport;
+      if (Module::ParseTransport(opts.Get("transport", ""), transport) != 0) {
+         std::cout << "Unknown transport: " << opts.Get("transport", "") << std::endl;
+         return 1;
+      }
+      config = Module::TransportConfig(transport);
+   }
+   mgr = new AMM::DDSManager<void>(config);
+
+   mgr->InitializeOperationalDescription();
+   mgr->CreateOperationalDescriptionSubscriber(&OnOperationalDescription);
+
+   mgr->InitializeModuleConfiguration();
+   mgr->CreateModuleConfigurationPublisher();
+   mgr->CreateModuleConfigurationSubscriber(&OnModuleConfiguration);
+
+   mgr->InitializeStatus();
+   mgr->CreateStatusSubscriber(&OnStatus);
+
+   mgr->InitializeSimulationControl();
+   mgr->CreateSimulationControlPublisher();
+
+   mgr->InitializeTick();
+   mgr->CreateTickPublisher();
+
+   /// Modules publish Operational Description at their start, so give them time to be found.
+   std::this_thread::sleep_for(std::chrono::duration<double>(settings.warmup));
+
+   Module::RunLoop loop;
+   std::size_t nextControl = 0;
+
+   SendControl(AMM::ControlType::RUN);
+   if (settings.controlPeriod > 0 && !settings.controls.empty()) {
+      loop.PostEvery(std::chrono::duration_cast<Module::RunLoop::Clock::duration>(
+         std::chrono::duration<double>(settings.controlPeriod)), [&]() {
+         SendControl(settings.controls[nextControl++ % settings.controls.size()]);
+      });
+   }
+   if (settings.stormPeriod > 0 && settings.stormSize > 0) {
+      loop.PostEvery(std::chrono::duration_cast<Module::RunLoop::Clock::duration>(
+         std::chrono::duration<double>(settings.stormPeriod)), [&]() {
+         SendStorm(settings);
+      });
+   }
+
+   std::atomic<bool> stop(false);
+   std::uint64_t ticksSent = 0;
+   Metrics::Histogram tickLateness;
+
+   auto start = Clock::now();
+   std::thread loopThread([&]() { loop.Run(); });
+   std::thread tickThread([&]() { SendTicks(settings, stop, ticksSent, tickLateness); });
+
+   std::this_thread::sleep_for(std::chrono::duration<double>(settings.duration));
+   stop = true;
+   tickThread.join();
+   loop.Stop();
+   loopThread.join();
+   double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+   /// Let the last responses arrive.
+   std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+   Metrics::Report report("load_generator");
+   report
+   .Add("duration_s", seconds)
+   .Add("tick_hz", settings.tickHz)
+   .Add("ticks_sent", ticksSent)
+   .Add("tick_rate_achieved", ticksSent / seconds)
+   .AddLatency("tick_lateness", tickLateness)
+   .Add("controls_sent", static_cast<std::uint64_t>(nextControl + 1));
+
+   {
+      std::lock_guard<std::mutex> lock(responseMutex);
+      report
+      .Add("modules", static_cast<std::uint64_t>(modules.size()))
+      .Add("save_requests", saveRequests)
+      .Add("save_unanswered", Unanswered(pendingSaves))
+      .AddLatency("save_response", saveResponse)
+      .Add("config_requests", configRequests)
+      .Add("config_foreign", foreignConfigs)
+      .Add("config_unanswered", Unanswered(pendingConfigs))
+      .AddLatency("config_response", configResponse);
+   }
+   report.Print(std::cout, settings.format);
+
+   mgr->Shutdown();
+   delete mgr;
+   return 0;
+}
+
+} // namespace LoadGen
+
+int main (int argc, char* argv[]) {
+
+   Metrics::Options opts;
+   for (int i = 1; i < argc; ++i) {
+      std::string arg = argv[i];
+
+      if (arg == "--help" || arg == "-h") {
+         std::cout
+         << " Usage: AMMLoadGenerator [--key=value ...]\n"
+         << "\n"
+         << " --duration=SECONDS         default 30\n"
+         << " --tick-hz=HZ               Tick rate, 50 to 10000, default 50\n"
+         << " --controls=RUN,HALT,...    Simulation Control sequence, repeated\n"
+         << " --control-period=SECONDS   between controls, default 2, 0 disables\n"
+         << " --storm-period=SECONDS     between Module Configuration storms, default 5, 0 disables\n"
+         << " --storm-size=N             configurations per storm, default 50\n"
+         << " --storm-foreign=FRACTION   share sent to unknown module IDs, default 0.5\n"
+         << " --warmup=SECONDS           module discovery time before starting, default 2\n"
+         << " --format=text|json|csv\n"
+         << " --config=PATH              default Config/Config.xml\n"
+         << " --transport=NAME           udp, shm or intra: use that shipped profile instead of --config\n";
+         return 0;
+      }
+
+      if (arg.compare(0, 2, "--") != 0) continue;
+      auto eq = arg.find('=');
+      if (eq == std::string::npos) opts.values[arg.substr(2)] = "";
+      else opts.values[arg.substr(2, eq - 2)] = arg.substr(eq + 1);
+   }
+
+   return LoadGen::Run(opts);
+}
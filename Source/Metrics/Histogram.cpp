@@ -0,0 +1,108 @@
+#include "Metrics/Histogram.h"
+
+#include <cmath>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Metrics {
+
+namespace {
+
+/// 2048 sub-buckets per bucket gives three significant digits.
+const int SubBucketHalfMagnitude = 10;
+const std::uint64_t SubBucketHalfCount = 1ull << SubBucketHalfMagnitude;
+const std::uint64_t SubBucketMask = (SubBucketHalfCount << 1) - 1;
+
+/// Index of the highest set bit. value must not be zero.
+int HighestBit (std::uint64_t value) {
+#if defined(_MSC_VER)
+   unsigned long index;
+   _BitScanReverse64(&index, value);
+   return static_cast<int>(index);
+#else
+   return 63 - __builtin_clzll(value);
+#endif
+}
+
+} // namespace
+
+Histogram::Histogram (std::uint64_t highest)
+   : m_highest(highest < SubBucketMask ? SubBucketMask : highest) {
+   int buckets = HighestBit(m_highest | SubBucketMask) - SubBucketHalfMagnitude + 1;
+   m_counts.assign(static_cast<std::size_t>(buckets + 1) << SubBucketHalfMagnitude, 0);
+}
+
+void Histogram::Record (std::uint64_t value) {
+   Record(value, 1);
+}
+
+void Histogram::Record (std::uint64_t value, std::uint64_t count) {
+   if (value > m_highest) value = m_highest;
+   m_counts[IndexOf(value)] += count;
+   m_total += count;
+   m_sum += static_cast<double>(value) * count;
+   if (value < m_min) m_min = value;
+   if (value > m_max) m_max = value;
+}
+
+void Histogram::Merge (const Histogram& other) {
+   for (std::size_t i = 0; i < m_counts.size() && i < other.m_counts.size(); ++i) {
+      m_counts[i] += other.m_counts[i];
+   }
+   m_total += other.m_total;
+   m_sum += other.m_sum;
+   if (other.m_total && other.m_min < m_min) m_min = other.m_min;
+   if (other.m_max > m_max) m_max = other.m_max;
+}
+
+void Histogram::Reset () {
+   for (auto& count : m_counts) count = 0;
+   m_total = 0;
+   m_min = ~0ull;
+   m_max = 0;
+   m_sum = 0.0;
+}
+
+double Histogram::Mean () const {
+   return m_total ? m_sum / m_total : 0.0;
+}
+
+std::uint64_t Histogram::ValueAtPercentile (double percentile) const {
+   if (m_total == 0) return 0;
+   if (percentile >= 100.0) return m_max;
+
+   auto target = static_cast<std::uint64_t>(std::ceil(percentile / 100.0 * m_total));
+   if (target == 0) target = 1;
+
+   std::uint64_t seen = 0;
+   for (std::size_t i = 0; i < m_counts.size(); ++i) {
+      seen += m_counts[i];
+      if (seen >= target) {
+         std::uint64_t value = HighestEquivalent(i);
+         return value > m_max ? m_max : value;
+      }
+   }
+   return m_max;
+}
+
+std::size_t Histogram::IndexOf (std::uint64_t value) const {
+   int bucket = HighestBit(value | SubBucketMask) - SubBucketHalfMagnitude;
+   std::uint64_t subBucket = value >> bucket;
+   return (static_cast<std::size_t>(bucket + 1) << SubBucketHalfMagnitude)
+        + static_cast<std::size_t>(subBucket - SubBucketHalfCount);
+}
+
+std::uint64_t Histogram::HighestEquivalent (std::size_t index) const {
+   int bucket = static_cast<int>(index >> SubBucketHalfMagnitude) - 1;
+   std::uint64_t subBucket = (index & (SubBucketHalfCount - 1)) + SubBucketHalfCount;
+   if (bucket < 0) {
+      subBucket -= SubBucketHalfCount;
+      bucket = 0;
+   }
+   std::uint64_t lowest = subBucket << bucket;
+   return lowest + (1ull << bucket) - 1;
+}
+
+} // namespace Metrics
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Metrics {
+
+/// High dynamic range histogram for latency values.
+///
+/// Values are kept to three significant digits across the whole range: each power of two
+/// gets 1024 linear sub-buckets, so recording is a couple of shifts and an increment, memory
+/// is fixed up front, and tail percentiles (p99.9, max) stay accurate without keeping every
+/// sample. Same layout as HdrHistogram with 3 significant figures.
+///
+/// Not thread safe. Record from one thread, or keep one per thread and Merge them.
+class Histogram {
+public:
+   /// Tracks values from 0 to highest. Larger values are clamped to highest.
+   /// The default covers one hour in nanoseconds.
+   explicit Histogram (std::uint64_t highest = 3600ull * 1000 * 1000 * 1000);
+
+   void Record (std::uint64_t value);
+   void Record (std::uint64_t value, std::uint64_t count);
+
+   /// Adds every value recorded in other. Both must track the same range.
+   void Merge (const Histogram& other);
+
+   void Reset ();
+
+   std::uint64_t Count () const { return m_total; }
+   std::uint64_t Min () const { return m_total ? m_min : 0; }
+   std::uint64_t Max () const { return m_max; }
+   double Mean () const;
+
+   /// Smallest recorded value that percentile percent of all values are at or below,
+   /// to within the histogram's precision. percentile is 0 to 100.
+   std::uint64_t ValueAtPercentile (double percentile) const;
+
+private:
+   std::size_t IndexOf (std::uint64_t value) const;
+   std::uint64_t HighestEquivalent (std::size_t index) const;
+
+   std::uint64_t m_highest;
+   std::vector<std::uint64_t> m_counts;
+   std::uint64_t m_total = 0;
+   std::uint64_t m_min = ~0ull;
+   std::uint64_t m_max = 0;
+   double m_sum = 0.0;
+};
+
+} // namespace Metrics
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdlib>
+#include <map>
+#include <string>
+
+namespace Metrics {
+
+/// Command line options in the form --key=value.
+/// Benchmarks and load tools read what they need and fall back to their own defaults.
+struct Options {
+   std::map<std::string, std::string> values;
+
+   bool Has (const std::string& key) const {
+      return values.count(key) != 0;
+   }
+
+   std::string Get (const std::string& key, const std::string& fallback) const {
+      auto it = values.find(key);
+      return it == values.end() ? fallback : it->second;
+   }
+
+   double GetDouble (const std::string& key, double fallback) const {
+      auto it = values.find(key);
+      return it == values.end() ? fallback : std::atof(it->second.c_str());
+   }
+
+   long long GetInt (const std::string& key, long long fallback) const {
+      auto it = values.find(key);
+      return it == values.end() ? fallback : std::atoll(it->second.c_str());
+   }
+};
+
+} // namespace Metrics
@@ -0,0 +1,113 @@
+#include "Metrics/Report.h"
+
+#include <sstream>
+
+namespace Metrics {
+
+namespace {
+
+std::string JsonEscape (const std::string& value) {
+   std::string escaped;
+   for (char c : value) {
+      switch (c) {
+      case '"':  escaped += "\\\""; break;
+      case '\\': escaped += "\\\\"; break;
+      case '\n': escaped += "\\n"; break;
+      default:   escaped += c; break;
+      }
+   }
+   return escaped;
+}
+
+std::string CsvEscape (const std::string& value) {
+   if (value.find_first_of(",\"\n") == std::string::npos) return value;
+   std::string escaped = "\"";
+   for (char c : value) {
+      if (c == '"') escaped += '"';
+      escaped += c;
+   }
+   return escaped + "\"";
+}
+
+} // namespace
+
+Format ParseFormat (const std::string& name) {
+   if (name == "json") return Format::Json;
+   if (name == "csv")  return Format::Csv;
+   return Format::Text;
+}
+
+Report::Report (std::string name)
+   : m_name(std::move(name)) {
+}
+
+Report& Report::Add (const std::string& key, const std::string& value) {
+   m_fields.push_back(Field{ key, value, true });
+   return *this;
+}
+
+Report& Report::Add (const std::string& key, const char* value) {
+   return Add(key, std::string(value));
+}
+
+Report& Report::Add (const std::string& key, double value) {
+   std::ostringstream out;
+   out << value;
+   m_fields.push_back(Field{ key, out.str(), false });
+   return *this;
+}
+
+Report& Report::Add (const std::string& key, std::int64_t value) {
+   m_fields.push_back(Field{ key, std::to_string(value), false });
+   return *this;
+}
+
+Report& Report::Add (const std::string& key, std::uint64_t value) {
+   m_fields.push_back(Field{ key, std::to_string(value), false });
+   return *this;
+}
+
+Report& Report::Add (const std::string& key, int value) {
+   return Add(key, static_cast<std::int64_t>(value));
+}
+
+Report& Report::AddLatency (const std::string& prefix, const Histogram& nanoseconds) {
+   Add(prefix + "_count", nanoseconds.Count());
+   Add(prefix + "_mean_us", nanoseconds.Mean() / 1000.0);
+   Add(prefix + "_p50_us", nanoseconds.ValueAtPercentile(50.0) / 1000.0);
+   Add(prefix + "_p99_us", nanoseconds.ValueAtPercentile(99.0) / 1000.0);
+   Add(prefix + "_p999_us", nanoseconds.ValueAtPercentile(99.9) / 1000.0);
+   Add(prefix + "_max_us", nanoseconds.Max() / 1000.0);
+   return *this;
+}
+
+void Report::Print (std::ostream& out, Format format) const {
+   switch (format) {
+
+   case Format::Text :
+      out << m_name;
+      for (auto& field : m_fields) out << " " << field.key << "=" << field.value;
+      out << std::endl;
+      break;
+
+   case Format::Json :
+      out << "{\"name\": \"" << JsonEscape(m_name) << "\"";
+      for (auto& field : m_fields) {
+         out << ", \"" << JsonEscape(field.key) << "\": ";
+         if (field.quoted) out << "\"" << JsonEscape(field.value) << "\"";
+         else out << field.value;
+      }
+      out << "}" << std::endl;
+      break;
+
+   case Format::Csv :
+      out << "name";
+      for (auto& field : m_fields) out << "," << CsvEscape(field.key);
+      out << "\n" << CsvEscape(m_name);
+      for (auto& field : m_fields) out << "," << CsvEscape(field.value);
+      out << std::endl;
+      break;
+   }
+}
+
+} // namespace Metrics
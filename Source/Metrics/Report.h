@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Metrics/Histogram.h"
+
+namespace Metrics {
+
+/// Output formats for results meant to be read by scripts.
+enum class Format {
+   /// name key=value key=value ...
+   Text,
+
+   /// One JSON object per report.
+   Json,
+
+   /// A header row and a value row.
+   Csv
+};
+
+/// Parses "text", "json" or "csv". Anything else is Text.
+Format ParseFormat (const std::string& name);
+
+/// An ordered set of named results from one run.
+class Report {
+public:
+   explicit Report (std::string name);
+
+   Report& Add (const std::string& key, const std::string& value);
+   Report& Add (const std::string& key, const char* value);
+   Report& Add (const std::string& key, double value);
+   Report& Add (const std::string& key, std::int64_t value);
+   Report& Add (const std::string& key, std::uint64_t value);
+   Report& Add (const std::string& key, int value);
+
+   /// Adds count, mean, p50, p99, p99.9 and max of a nanosecond histogram, in microseconds,
+   /// as <prefix>_count, <prefix>_mean_us, <prefix>_p50_us and so on.
+   Report& AddLatency (const std::string& prefix, const Histogram& nanoseconds);
+
+   void Print (std::ostream& out, Format format) const;
+
+private:
+   struct Field {
+      std::string key;
+      std::string value;
+      bool quoted;
+   };
+
+   std::string m_name;
+   std::vector<Field> m_fields;
+};
+
+} // namespace Metrics
@@ -0,0 +1,40 @@
+#include "Module/DdsError.h"
+
+namespace Module {
+
+namespace {
+
+class DdsErrorCategory : public std::error_category {
+public:
+   const char* name () const noexcept override {
+      return "dds_manager";
+   }
+
+   std::string message (int value) const override {
+      switch (static_cast<DdsErrc>(value)) {
+         case DdsErrc::CallFailed:         return "DDS Manager call failed";
+         case DdsErrc::TypeNotInitialized: return "topic type is not initialized";
+         case DdsErrc::NoPublisher:        return "no publisher for this topic";
+         case DdsErrc::WriteFailed:        return "DDS Manager write failed";
+         default:                          return "unknown DDS Manager error";
+      }
+   }
+};
+
+} // namespace
+
+const std::error_category& DdsCategory () {
+   static DdsErrorCategory category;
+   return category;
+}
+
+std::error_code make_error_code (DdsErrc errc) {
+   return std::error_code(static_cast<int>(errc), DdsCategory());
+}
+
+std::string DdsResult::Message () const {
+   if (Ok()) return std::string();
+   return std::string(m_operation) + ": " + m_code.message();
+}
+
+} // namespace Module
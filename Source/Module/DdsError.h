@@ -0,0 +1,96 @@
+#pragma once
+
+#include <string>
+#include <system_error>
+
+namespace Module {
+
+/// Errors reported by DDS Manager calls, as std::error_code values.
+///
+/// DDS Manager methods return 0 or 1, and only the errmsg overloads say why a call failed.
+/// Those format a message into a string on every call, successful or not, which a hot path
+/// like WriteAssessment should not pay for. Calling the plain overload and wrapping its
+/// return code in a DdsResult costs nothing on success; the message is built only if
+/// Message is asked for.
+///
+///    Module::DdsResult result(mgr->WriteAssessment(a), setup.WriteFailure(), "WriteAssessment");
+///    if (!result.Ok()) Module::Log().Error(result.Message());
+///
+/// DDS Manager returns the same 1 whatever went wrong. What tells the failures of a write
+/// apart is the setup the module did before it, which DdsSetup records.
+///
+/// When the library's own explanation is needed, for one-off calls like Initialize or
+/// Shutdown, use the errmsg overload as shown in Tutorial 5.
+enum class DdsErrc {
+   /// DDS Manager returned a non-zero code. It gives no more detail without errmsg.
+   CallFailed = 1,
+
+   /// The topic type was not initialized, or its initialization failed.
+   TypeNotInitialized,
+
+   /// No publisher was created for the topic, or creating it failed.
+   NoPublisher,
+
+   /// Everything was set up, and DDS Manager still rejected the write.
+   WriteFailed
+};
+
+const std::error_category& DdsCategory ();
+
+std::error_code make_error_code (DdsErrc errc);
+
+/// What a module has set up for one topic it publishes, from the return codes of the calls
+/// that did it. Tells which DdsErrc a failed write of that topic stands for.
+struct DdsSetup {
+   bool typeInitialized = false;
+   bool publisherCreated = false;
+
+   DdsErrc WriteFailure () const {
+      if (!typeInitialized) return DdsErrc::TypeNotInitialized;
+      if (!publisherCreated) return DdsErrc::NoPublisher;
+      return DdsErrc::WriteFailed;
+   }
+};
+
+/// Outcome of one DDS Manager call. Holds only a code and the name of the call, so creating,
+/// copying and testing one never allocates.
+class DdsResult {
+public:
+   DdsResult () = default;
+
+   /// operation must be a string literal or otherwise outlive the result.
+   DdsResult (int returnCode, const char* operation)
+      : m_code(returnCode == 0 ? std::error_code() : make_error_code(DdsErrc::CallFailed)),
+        m_operation(operation) {
+   }
+
+   /// Records failure as the reason when returnCode is non-zero.
+   DdsResult (int returnCode, DdsErrc failure, const char* operation)
+      : m_code(returnCode == 0 ? std::error_code() : make_error_code(failure)),
+        m_operation(operation) {
+   }
+
+   DdsResult (DdsErrc errc, const char* operation)
+      : m_code(make_error_code(errc)), m_operation(operation) {
+   }
+
+   bool Ok () const { return !m_code; }
+   const std::error_code& Code () const { return m_code; }
+   const char* Operation () const { return m_operation; }
+
+   /// "<operation>: <description>", formatted on each call. Empty on success.
+   std::string Message () const;
+
+private:
+   std::error_code m_code;
+   const char* m_operation = "";
+};
+
+} // namespace Module
+
+namespace std {
+
+template <>
+struct is_error_code_enum<Module::DdsErrc> : true_type {};
+
+} // namespace std
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <amm_std.h>
+
+namespace Module {
+
+/// A callable stored inside the object itself, never on the heap.
+///
+/// Like std::function, but the callable must fit in Capacity bytes, which is checked at
+/// compile time, so wrapping a capturing lambda never allocates and calling it is one
+/// indirect call with no allocation or reference counting. Move only.
+template <typename Signature, std::size_t Capacity = 48>
+class InlineFunction;
+
+template <typename R, typename... Args, std::size_t Capacity>
+class InlineFunction<R(Args...), Capacity> {
+public:
+   InlineFunction () = default;
+
+   template <typename F, typename = typename std::enable_if<
+      !std::is_same<typename std::decay<F>::type, InlineFunction>::value>::type>
+   InlineFunction (F&& f) {
+      using Stored = typename std::decay<F>::type;
+      static_assert(sizeof(Stored) <= Capacity, "Callable too large for InlineFunction; capture less or raise Capacity");
+      static_assert(alignof(Stored) <= alignof(std::max_align_t), "Callable over-aligned for InlineFunction");
+
+      new (&m_storage) Stored(std::forward<F>(f));
+      m_ops = &OpsFor<Stored>::ops;
+   }
+
+   InlineFunction (InlineFunction&& other) noexcept {
+      MoveFrom(other);
+   }
+
+   InlineFunction& operator= (InlineFunction&& other) noexcept {
+      if (this != &other) {
+         Reset();
+         MoveFrom(other);
+      }
+      return *this;
+   }
+
+   InlineFunction (const InlineFunction&) = delete;
+   InlineFunction& operator= (const InlineFunction&) = delete;
+
+   ~InlineFunction () {
+      Reset();
+   }
+
+   explicit operator bool () const { return m_ops != nullptr; }
+
+   R operator() (Args... args) const {
+      return m_ops->invoke(const_cast<void*>(static_cast<const void*>(&m_storage)), std::forward<Args>(args)...);
+   }
+
+private:
+   struct Ops {
+      R (*invoke) (void* storage, Args&&... args);
+      void (*move) (void* from, void* to);
+      void (*destroy) (void* storage);
+   };
+
+   template <typename Stored>
+   struct OpsFor {
+      static R Invoke (void* storage, Args&&... args) {
+         return (*static_cast<Stored*>(storage))(std::forward<Args>(args)...);
+      }
+      static void Move (void* from, void* to) {
+         new (to) Stored(std::move(*static_cast<Stored*>(from)));
+         static_cast<Stored*>(from)->~Stored();
+      }
+      static void Destroy (void* storage) {
+         static_cast<Stored*>(storage)->~Stored();
+      }
+      static const Ops ops;
+   };
+
+   void MoveFrom (InlineFunction& other) {
+      if (other.m_ops == nullptr) return;
+      other.m_ops->move(&other.m_storage, &m_storage);
+      m_ops = other.m_ops;
+      other.m_ops = nullptr;
+   }
+
+   void Reset () {
+      if (m_ops == nullptr) return;
+      m_ops->destroy(&m_storage);
+      m_ops = nullptr;
+   }
+
+   typename std::aligned_storage<Capacity, alignof(std::max_align_t)>::type m_storage;
+   const Ops* m_ops = nullptr;
+};
+
+template <typename R, typename... Args, std::size_t Capacity>
+template <typename Stored>
+const typename InlineFunction<R(Args...), Capacity>::Ops
+InlineFunction<R(Args...), Capacity>::OpsFor<Stored>::ops = {
+   &OpsFor<Stored>::Invoke, &OpsFor<Stored>::Move, &OpsFor<Stored>::Destroy
+};
+
+/// Several handlers for one AMM topic on one DDS Manager.
+///
+/// A DDS Manager binds each subscriber to a single callback: a plain function in
+/// DDSManager<void>, or a member of the one class a DDSManager<Foo> was declared with.
+/// A dispatcher is that single callback, and calls every handler subscribed to it in turn.
+/// Handlers can be capturing lambdas, members of any class, or plain functions, and calling
+/// them allocates nothing.
+///
+///    auto& assessments = Module::Dispatcher<AMM::Assessment>::Get();
+///    auto fooSubscription = assessments.Subscribe([&foo](AMM::Assessment& a) { foo.OnAssessment(a); });
+///    auto logSubscription = assessments.Subscribe([&log](AMM::Assessment& a) { log.Record(a); });
+///    mgr->CreateAssessmentSubscriber(&Module::Dispatch<AMM::Assessment>);
+///
+/// Subscribe returns a Subscription, and the handler stays subscribed until it is destroyed,
+/// so keep it alongside whatever the handler refers to.
+///
+/// Subscribe and unsubscribe only while no subscriber delivers to the dispatcher: before
+/// creating the subscriber, or after removing it. Dispatch reads the handler list without
+/// locking, from whichever FastRTPS listener thread delivers the sample.
+template <typename T>
+class Dispatcher {
+public:
+   using Handler = InlineFunction<void(T&)>;
+
+   /// The dispatcher Dispatch<T> delivers to.
+   static Dispatcher& Get () {
+      static Dispatcher dispatcher;
+      return dispatcher;
+   }
+
+   /// Keeps one handler subscribed. Unsubscribes it when destroyed. Move only.
+   class Subscription {
+   public:
+      Subscription () = default;
+
+      Subscription (Subscription&& other) noexcept
+         : m_dispatcher(other.m_dispatcher), m_id(other.m_id) {
+         other.m_dispatcher = nullptr;
+      }
+
+      Subscription& operator= (Subscription&& other) noexcept {
+         if (this != &other) {
+            Unsubscribe();
+            m_dispatcher = other.m_dispatcher;
+            m_id = other.m_id;
+            other.m_dispatcher = nullptr;
+         }
+         return *this;
+      }
+
+      Subscription (const Subscription&) = delete;
+      Subscription& operator= (const Subscription&) = delete;
+
+      ~Subscription () {
+         Unsubscribe();
+      }
+
+      /// False if the handler was rejected, or has already been unsubscribed.
+      bool Active () const { return m_dispatcher != nullptr; }
+
+      void Unsubscribe () {
+         if (m_dispatcher == nullptr) return;
+         m_dispatcher->Remove(m_id);
+         m_dispatcher = nullptr;
+      }
+
+   private:
+      friend class Dispatcher;
+
+      Subscription (Dispatcher* dispatcher, std::uint64_t id)
+         : m_dispatcher(dispatcher), m_id(id) {
+      }
+
+      Dispatcher* m_dispatcher = nullptr;
+      std::uint64_t m_id = 0;
+   };
+
+   Dispatcher () = default;
+
+   Dispatcher (const Dispatcher&) = delete;
+   Dispatcher& operator= (const Dispatcher&) = delete;
+
+   /// Adds a handler, called after those already subscribed. An empty handler is rejected,
+   /// and the Subscription returned for it is not Active.
+   Subscription Subscribe (Handler handler) {
+      if (!handler) return Subscription();
+
+      std::uint64_t id = m_nextId++;
+      m_handlers.push_back(Entry{ id, std::move(handler) });
+      return Subscription(this, id);
+   }
+
+   /// Adds a member function of receiver as a handler.
+   template <typename Receiver>
+   Subscription Subscribe (Receiver* receiver, void (Receiver::*method) (T&)) {
+      if (receiver == nullptr || method == nullptr) return Subscription();
+      return Subscribe(Handler([receiver, method](T& sample) { (receiver->*method)(sample); }));
+   }
+
+   void Dispatch (T& sample) const {
+      for (auto& entry : m_handlers) entry.handler(sample);
+   }
+
+   std::size_t Size () const { return m_handlers.size(); }
+
+private:
+   struct Entry {
+      std::uint64_t id;
+      Handler handler;
+   };
+
+   void Remove (std::uint64_t id) {
+      auto found = std::find_if(m_handlers.begin(), m_handlers.end(),
+                                [id](const Entry& entry) { return entry.id == id; });
+      if (found != m_handlers.end()) m_handlers.erase(found);
+   }
+
+   std::vector<Entry> m_handlers;
+   std::uint64_t m_nextId = 0;
+};
+
+/// DDS Manager subscriber callback that delivers to Dispatcher<T>::Get().
+template <typename T>
+void Dispatch (T& sample, eprosima::fastrtps::SampleInfo_t* info) {
+   Dispatcher<T>::Get().Dispatch(sample);
+}
+
+} // namespace Module
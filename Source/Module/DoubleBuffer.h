@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace Module {
+
+/// Two copies of a value that readers access without taking a lock.
+///
+/// Readers pin whichever copy is active. A writer changes the inactive copy, makes it active,
+/// waits for readers still pinned on the old copy to let go, then applies the same change to
+/// the old copy so both stay identical. Readers never wait for writers and never see a
+/// half-written value. Writers are serialized with each other and wait only for readers,
+/// so read sections should stay short.
+template <typename T>
+class DoubleBuffer {
+public:
+
+   /// Keeps one copy pinned for as long as it is alive.
+   class ReadGuard {
+   public:
+      ReadGuard (ReadGuard&& other) : m_owner(other.m_owner), m_index(other.m_index) {
+         other.m_owner = nullptr;
+      }
+
+      ReadGuard (const ReadGuard&) = delete;
+      ReadGuard& operator= (const ReadGuard&) = delete;
+
+      ~ReadGuard () {
+         if (m_owner) m_owner->m_readers[m_index].fetch_sub(1);
+      }
+
+      const T& operator* () const { return m_owner->m_slots[m_index]; }
+      const T* operator-> () const { return &m_owner->m_slots[m_index]; }
+
+   private:
+      friend class DoubleBuffer;
+
+      ReadGuard (const DoubleBuffer* owner, int index) : m_owner(owner), m_index(index) {}
+
+      const DoubleBuffer* m_owner;
+      int m_index;
+   };
+
+   explicit DoubleBuffer (const T& initial = T())
+      : m_slots{ initial, initial }, m_active(0) {
+      m_readers[0] = 0;
+      m_readers[1] = 0;
+   }
+
+   DoubleBuffer (const DoubleBuffer&) = delete;
+   DoubleBuffer& operator= (const DoubleBuffer&) = delete;
+
+   /// Pins the current copy. Never blocks.
+   ReadGuard Read () const {
+      for (;;) {
+         int index = m_active.load();
+         m_readers[index].fetch_add(1);
+
+         /// A writer may have switched copies between the load and the pin. Only keep the pin
+         /// if this copy is still the active one, since the writer will wait for it to drop.
+         if (m_active.load() == index) return ReadGuard(this, index);
+         m_readers[index].fetch_sub(1);
+      }
+   }
+
+   /// Applies fn to both copies, one at a time. fn must be deterministic, since it runs twice.
+   template <typename Fn>
+   void Modify (Fn fn) {
+      std::lock_guard<std::mutex> lock(m_writer);
+
+      int back = 1 - m_active.load();
+      WaitForReaders(back);
+      fn(m_slots[back]);
+
+      m_active.store(back);
+
+      int front = 1 - back;
+      WaitForReaders(front);
+      fn(m_slots[front]);
+   }
+
+   /// Replaces the value.
+   void Store (const T& value) {
+      Modify([&value](T& slot) { slot = value; });
+   }
+
+private:
+   void WaitForReaders (int index) const {
+      while (m_readers[index].load() != 0) std::this_thread::yield();
+   }
+
+   T m_slots[2];
+   mutable std::atomic<int> m_readers[2];
+   std::atomic<int> m_active;
+   std::mutex m_writer;
+};
+
+} // namespace Module
@@ -0,0 +1,368 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "Module/RunLoop.h"
+
+namespace Module {
+
+/// Bounded lock-free ring buffer.
+///
+/// Each slot carries a sequence number that tells producers and consumers whose turn it is,
+/// so neither side takes a lock. Producers and consumers claim slots with a compare-and-swap,
+/// which keeps the buffer safe when a subscriber's listener fires from more than one receive
+/// thread, and lets a producer discard the oldest element to make room.
+template <typename T>
+class RingBuffer {
+public:
+   /// Capacity is rounded up to a power of two.
+   explicit RingBuffer (std::size_t capacity)
+      : m_mask(RoundUp(capacity) - 1),
+        m_slots(new Slot[m_mask + 1]),
+        m_head(0), m_tail(0) {
+      for (std::size_t i = 0; i <= m_mask; ++i) m_slots[i].seq.store(i, std::memory_order_relaxed);
+   }
+
+   RingBuffer (const RingBuffer&) = delete;
+   RingBuffer& operator= (const RingBuffer&) = delete;
+
+   /// Moves value into the buffer unless it is full.
+   /// wake is set when the consumer may have found the buffer empty and stopped draining,
+   /// in which case the caller must wake it.
+   bool TryPush (T& value, bool& wake) {
+      std::size_t pos = m_tail.load(std::memory_order_relaxed);
+      for (;;) {
+         Slot& slot = m_slots[pos & m_mask];
+         std::size_t seq = slot.seq.load(std::memory_order_acquire);
+         auto dif = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+         if (dif == 0) {
+            if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+               slot.value = std::move(value);
+
+               /// Both sides are sequentially consistent here. Either the consumer's claim of
+               /// this position is visible to the load below, or the consumer sees this store.
+               slot.seq.store(pos + 1, std::memory_order_seq_cst);
+               wake = m_head.load(std::memory_order_seq_cst) == pos;
+               return true;
+            }
+         } else if (dif < 0) {
+            return false;
+         } else {
+            pos = m_tail.load(std::memory_order_relaxed);
+         }
+      }
+   }
+
+   /// Moves the oldest element into out unless the buffer is empty.
+   bool TryPop (T& out) {
+      std::size_t pos = m_head.load(std::memory_order_relaxed);
+      for (;;) {
+         Slot& slot = m_slots[pos & m_mask];
+         std::size_t seq = slot.seq.load(std::memory_order_seq_cst);
+         auto dif = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+         if (dif == 0) {
+            if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_seq_cst)) {
+               out = std::move(slot.value);
+               slot.seq.store(pos + m_mask + 1, std::memory_order_release);
+               return true;
+            }
+         } else if (dif < 0) {
+            return false;
+         } else {
+            pos = m_head.load(std::memory_order_relaxed);
+         }
+      }
+   }
+
+   /// Like TryPush, but calls fill with the slot's element to write it in place.
+   /// The element still holds whatever was last written there, so copy assigning into it
+   /// reuses its string and vector storage instead of allocating.
+   template <typename Fill>
+   bool TryPushWith (Fill&& fill, bool& wake) {
+      std::size_t pos = m_tail.load(std::memory_order_relaxed);
+      for (;;) {
+         Slot& slot = m_slots[pos & m_mask];
+         std::size_t seq = slot.seq.load(std::memory_order_acquire);
+         auto dif = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+         if (dif == 0) {
+            if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+               fill(slot.value);
+               slot.seq.store(pos + 1, std::memory_order_seq_cst);
+               wake = m_head.load(std::memory_order_seq_cst) == pos;
+               return true;
+            }
+         } else if (dif < 0) {
+            return false;
+         } else {
+            pos = m_tail.load(std::memory_order_relaxed);
+         }
+      }
+   }
+
+   /// Like TryPop, but swaps the oldest element with out instead of moving it, so the slot
+   /// keeps out's old storage for the next TryPushWith. The slot is free again before this
+   /// returns, so whatever the caller then does with out never holds up producers.
+   bool TrySwapOut (T& out) {
+      std::size_t pos = m_head.load(std::memory_order_relaxed);
+      for (;;) {
+         Slot& slot = m_slots[pos & m_mask];
+         std::size_t seq = slot.seq.load(std::memory_order_seq_cst);
+         auto dif = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+         if (dif == 0) {
+            if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_seq_cst)) {
+               using std::swap;
+               swap(out, slot.value);
+               slot.seq.store(pos + m_mask + 1, std::memory_order_seq_cst);
+               return true;
+            }
+         } else if (dif < 0) {
+            return false;
+         } else {
+            pos = m_head.load(std::memory_order_relaxed);
+         }
+      }
+   }
+
+   /// Frees the oldest element's slot without reading it, unless the buffer is empty.
+   /// The element keeps its storage for the next TryPushWith.
+   bool TryDiscard () {
+      std::size_t pos = m_head.load(std::memory_order_relaxed);
+      for (;;) {
+         Slot& slot = m_slots[pos & m_mask];
+         std::size_t seq = slot.seq.load(std::memory_order_seq_cst);
+         auto dif = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+         if (dif == 0) {
+            if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_seq_cst)) {
+               slot.seq.store(pos + m_mask + 1, std::memory_order_seq_cst);
+               return true;
+            }
+         } else if (dif < 0) {
+            return false;
+         } else {
+            pos = m_head.load(std::memory_order_relaxed);
+         }
+      }
+   }
+
+   /// Approximate number of elements. Exact when no push or pop is in flight.
+   std::size_t Size () const {
+      std::size_t tail = m_tail.load(std::memory_order_relaxed);
+      std::size_t head = m_head.load(std::memory_order_relaxed);
+      return tail > head ? tail - head : 0;
+   }
+
+   std::size_t Capacity () const {
+      return m_mask + 1;
+   }
+
+   /// Whether the next push would find its slot free. Reads the slot's sequence rather than
+   /// the head and tail, so it only turns true once the consumer has actually released the
+   /// slot, and a producer that sees true after a TrySwapOut or TryDiscard sees that room.
+   bool HasRoom () const {
+      std::size_t pos = m_tail.load(std::memory_order_seq_cst);
+      std::size_t seq = m_slots[pos & m_mask].seq.load(std::memory_order_seq_cst);
+      return static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos) >= 0;
+   }
+
+private:
+   struct Slot {
+      std::atomic<std::size_t> seq;
+      T value;
+   };
+
+   static std::size_t RoundUp (std::size_t n) {
+      std::size_t size = 2;
+      while (size < n) size <<= 1;
+      return size;
+   }
+
+   const std::size_t m_mask;
+   std::unique_ptr<Slot[]> m_slots;
+
+   /// Kept on separate cache lines so producers and the consumer do not contend.
+   alignas(64) std::atomic<std::size_t> m_head;
+   alignas(64) std::atomic<std::size_t> m_tail;
+};
+
+/// What a HandoffQueue does when a sample arrives and the queue is full.
+enum class OverflowPolicy {
+   /// Discard the oldest queued sample. The producer never waits.
+   /// Suited to streams where only recent data matters, like Tick.
+   DropOldest,
+
+   /// Make the producer wait for room, up to the queue's block timeout. Nothing is lost
+   /// unless the loop stays stuck that long, but the listener thread stalls while the module
+   /// falls behind. Suited to control topics like Simulation Control.
+   Block
+};
+
+/// Hands samples from a DDS Manager subscriber callback to a module's RunLoop thread.
+///
+/// The callback pushes a copy of the sample and returns immediately, so slow module logic
+/// no longer delays sample delivery on the FastRTPS listener thread. The handler runs on
+/// the loop thread each time it wakes, draining everything queued so far in order.
+///
+/// Queues drain in priority order. A Control queue, for Simulation Control, also drains
+/// between every sample handled from lower priority queues, so a flood of other data
+/// delays a HALT by at most one sample's handling.
+///
+/// Samples are copied once, into storage the queue keeps and reuses. The loop thread swaps
+/// each one out with a spare entry rather than moving it, so storage circulates between the
+/// slots and the spare. Once every slot has held a sample of typical size, handing off even
+/// string-heavy types like Operational Description or Module Configuration allocates nothing.
+template <typename T>
+class HandoffQueue {
+public:
+   using Clock = RunLoop::Clock;
+   using Handler = std::function<void(T&)>;
+
+   struct Stats {
+      std::size_t depth;
+      std::size_t maxDepth;
+      std::uint64_t pushed;
+      std::uint64_t delivered;
+      std::uint64_t dropped;
+
+      /// Time from Push to the start of the handler, over every delivered sample.
+      Clock::duration latencyTotal;
+      Clock::duration latencyMax;
+   };
+
+   /// Register before the loop starts running.
+   /// Under the Block policy a producer waits at most blockTimeout for room. Samples pushed
+   /// before Run starts wait for it the same way, so a full queue at startup is not lost.
+   HandoffQueue (RunLoop& loop, std::size_t capacity, OverflowPolicy policy, Handler handler,
+                 RunLoop::Priority priority = RunLoop::Priority::Normal,
+                 Clock::duration blockTimeout = std::chrono::seconds(2))
+      : m_loop(loop), m_ring(capacity), m_policy(policy), m_handler(std::move(handler)),
+        m_priority(priority), m_blockTimeout(blockTimeout), m_waiters(0),
+        m_maxDepth(0), m_pushed(0), m_delivered(0), m_dropped(0),
+        m_latencyTotal(0), m_latencyMax(0) {
+      m_loop.AddWakeHandler([this]() { Drain(); }, priority, this);
+   }
+
+   /// Removes the queue's wake handler. Destroy while the loop is not running.
+   ~HandoffQueue () {
+      m_loop.Cancel(this);
+   }
+
+   HandoffQueue (const HandoffQueue&) = delete;
+   HandoffQueue& operator= (const HandoffQueue&) = delete;
+
+   /// Queues a copy of value for the loop thread.
+   /// Returns false if the sample was dropped, which only happens under the Block policy
+   /// when the queue stayed full for the whole block timeout.
+   bool Push (const T& value) {
+      auto enqueued = Clock::now();
+      auto fill = [&value, enqueued](Entry& entry) {
+         entry.value = value;
+         entry.enqueued = enqueued;
+      };
+      bool wake = false;
+
+      for (;;) {
+         if (m_ring.TryPushWith(fill, wake)) break;
+
+         if (m_policy == OverflowPolicy::DropOldest) {
+            if (m_ring.TryDiscard()) m_dropped.fetch_add(1, std::memory_order_relaxed);
+         } else if (!WaitForRoom(enqueued + m_blockTimeout)) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+         }
+      }
+
+      m_pushed.fetch_add(1, std::memory_order_relaxed);
+
+      std::size_t depth = m_ring.Size();
+      std::size_t maxDepth = m_maxDepth.load(std::memory_order_relaxed);
+      while (depth > maxDepth && !m_maxDepth.compare_exchange_weak(maxDepth, depth)) {}
+
+      /// The loop drains until the buffer is empty, so it only needs waking when it may have
+      /// stopped short of this sample.
+      if (wake) m_loop.Notify();
+      return true;
+   }
+
+   Stats GetStats () const {
+      Stats stats;
+      stats.depth = m_ring.Size();
+      stats.maxDepth = m_maxDepth.load(std::memory_order_relaxed);
+      stats.pushed = m_pushed.load(std::memory_order_relaxed);
+      stats.delivered = m_delivered.load(std::memory_order_relaxed);
+      stats.dropped = m_dropped.load(std::memory_order_relaxed);
+      stats.latencyTotal = Clock::duration(m_latencyTotal.load(std::memory_order_relaxed));
+      stats.latencyMax = Clock::duration(m_latencyMax.load(std::memory_order_relaxed));
+      return stats;
+   }
+
+private:
+   struct Entry {
+      T value;
+      Clock::time_point enqueued;
+   };
+
+   /// Sleeps until the loop frees a slot or the deadline passes. Returns false on timeout.
+   bool WaitForRoom (Clock::time_point deadline) {
+      std::unique_lock<std::mutex> lock(m_roomMutex);
+      m_waiters.fetch_add(1, std::memory_order_seq_cst);
+
+      /// Make sure a loop that has not started yet, or went back to sleep, drains this queue.
+      m_loop.Notify();
+      bool room = m_roomCv.wait_until(lock, deadline, [this]() { return m_ring.HasRoom(); });
+      m_waiters.fetch_sub(1, std::memory_order_relaxed);
+      return room;
+   }
+
+   /// Each sample is swapped out of the ring into m_spare and its slot released before the
+   /// handler runs, so a slow or throwing handler never keeps a slot claimed.
+   void Drain () {
+      while (m_ring.TrySwapOut(m_spare)) {
+         if (m_waiters.load(std::memory_order_seq_cst) > 0) {
+            std::lock_guard<std::mutex> lock(m_roomMutex);
+            m_roomCv.notify_all();
+         }
+
+         auto latency = (Clock::now() - m_spare.enqueued).count();
+         m_latencyTotal.fetch_add(latency, std::memory_order_relaxed);
+         if (latency > m_latencyMax.load(std::memory_order_relaxed)) {
+            m_latencyMax.store(latency, std::memory_order_relaxed);
+         }
+         m_delivered.fetch_add(1, std::memory_order_relaxed);
+         m_handler(m_spare.value);
+
+         if (m_priority != RunLoop::Priority::Control) m_loop.ServiceControl();
+      }
+   }
+
+   RunLoop& m_loop;
+   RingBuffer<Entry> m_ring;
+
+   /// Loop thread only. Holds the sample being handled, and trades storage with the ring.
+   Entry m_spare;
+   OverflowPolicy m_policy;
+   Handler m_handler;
+   RunLoop::Priority m_priority;
+
+   /// Block policy only. Producers waiting for room sleep here until Drain frees a slot.
+   Clock::duration m_blockTimeout;
+   std::mutex m_roomMutex;
+   std::condition_variable m_roomCv;
+   std::atomic<int> m_waiters;
+
+   std::atomic<std::size_t> m_maxDepth;
+   std::atomic<std::uint64_t> m_pushed;
+   std::atomic<std::uint64_t> m_delivered;
+   std::atomic<std::uint64_t> m_dropped;
+   std::atomic<Clock::rep> m_latencyTotal;
+   std::atomic<Clock::rep> m_latencyMax;
+};
+
+} // namespace Module
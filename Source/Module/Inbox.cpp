@@ -0,0 +1,119 @@
+#include "Module/Inbox.h"
+
+#include <utility>
+
+namespace Module {
+
+Inbox::Inbox (const AMM::UUID* moduleId, std::size_t tickCapacity)
+   : m_moduleId(moduleId), m_tickCapacity(tickCapacity ? tickCapacity : 1) {
+}
+
+void Inbox::OnTick (const AMM::Tick& tick) {
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_ticks.size() >= m_tickCapacity) {
+         m_ticks.pop_front();
+         m_stats.droppedTicks++;
+      }
+      m_ticks.push_back(tick);
+      m_stats.ticks++;
+   }
+   m_cv.notify_all();
+}
+
+void Inbox::OnSimulationControl (const AMM::SimulationControl& simControl) {
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_simulationControls.push_back(simControl);
+      m_stats.simulationControls++;
+   }
+   m_cv.notify_all();
+}
+
+void Inbox::OnModuleConfiguration (const AMM::ModuleConfiguration& modConfig) {
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (modConfig.module_id().id() != m_moduleId->id()) {
+         m_stats.foreignConfigurations++;
+         return;
+      }
+      m_moduleConfigurations.push_back(modConfig);
+      m_stats.moduleConfigurations++;
+   }
+   m_cv.notify_all();
+}
+
+template <typename Ready>
+bool Inbox::Wait (std::unique_lock<std::mutex>& lock, Clock::duration timeout, Ready ready) {
+   auto done = [this, &ready]() { return ready() || m_stopped; };
+   if (timeout == Clock::duration::max()) {
+      m_cv.wait(lock, done);
+   } else {
+      m_cv.wait_for(lock, timeout, done);
+   }
+   return ready();
+}
+
+Inbox::Event Inbox::Next (Clock::duration timeout) {
+   Event event;
+   std::unique_lock<std::mutex> lock(m_mutex);
+
+   bool ready = Wait(lock, timeout, [this]() {
+      return !m_simulationControls.empty() || !m_moduleConfigurations.empty() || !m_ticks.empty();
+   });
+   if (!ready) {
+      event.kind = m_stopped ? Kind::Stopped : Kind::Timeout;
+   } else if (!m_simulationControls.empty()) {
+      event.kind = Kind::SimulationControl;
+      event.simulationControl = std::move(m_simulationControls.front());
+      m_simulationControls.pop_front();
+   } else if (!m_moduleConfigurations.empty()) {
+      event.kind = Kind::ModuleConfiguration;
+      event.moduleConfiguration = std::move(m_moduleConfigurations.front());
+      m_moduleConfigurations.pop_front();
+   } else {
+      event.kind = Kind::Tick;
+      event.tick = m_ticks.front();
+      m_ticks.pop_front();
+   }
+   return event;
+}
+
+bool Inbox::NextTick (AMM::Tick& tick, Clock::duration timeout) {
+   std::unique_lock<std::mutex> lock(m_mutex);
+   if (!Wait(lock, timeout, [this]() { return !m_ticks.empty(); })) return false;
+   tick = m_ticks.front();
+   m_ticks.pop_front();
+   return true;
+}
+
+bool Inbox::NextSimulationControl (AMM::SimulationControl& simControl, Clock::duration timeout) {
+   std::unique_lock<std::mutex> lock(m_mutex);
+   if (!Wait(lock, timeout, [this]() { return !m_simulationControls.empty(); })) return false;
+   simControl = std::move(m_simulationControls.front());
+   m_simulationControls.pop_front();
+   return true;
+}
+
+bool Inbox::NextModuleConfiguration (AMM::ModuleConfiguration& modConfig, Clock::duration timeout) {
+   std::unique_lock<std::mutex> lock(m_mutex);
+   if (!Wait(lock, timeout, [this]() { return !m_moduleConfigurations.empty(); })) return false;
+   modConfig = std::move(m_moduleConfigurations.front());
+   m_moduleConfigurations.pop_front();
+   return true;
+}
+
+void Inbox::Stop () {
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stopped = true;
+   }
+   m_cv.notify_all();
+}
+
+Inbox::Stats Inbox::GetStats () const {
+   std::lock_guard<std::mutex> lock(m_mutex);
+   return m_stats;
+}
+
+} // namespace Module
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+#include <amm_std.h>
+
+namespace Module {
+
+/// Lets module logic wait for its next input in straight-line code.
+///
+/// Instead of spreading a module across free callbacks and globals, its logic can run as one
+/// function on one thread that asks for what it needs next:
+///
+///    Module::Inbox inbox(&moduleId);
+///    // Subscriber callbacks: inbox.OnTick(tick), inbox.OnSimulationControl(sc), ...
+///
+///    void ModuleMain () {
+///       AMM::ModuleConfiguration config;
+///       inbox.NextModuleConfiguration(config);      // wait to be configured
+///       for (;;) {
+///          auto event = inbox.Next();
+///          if (event.kind == Module::Inbox::Kind::Stopped) return;
+///          ...
+///       }
+///    }
+///
+/// Everything the module keeps lives in ModuleMain's locals, and since only that thread
+/// touches them they need no locks. Samples that arrive while the module waits for something
+/// else stay queued in order. Next returns Simulation Control first, then Module
+/// Configuration, then Ticks, so a HALT is never stuck behind a backlog of Ticks. Ticks are
+/// bounded and the oldest is dropped when full; control and configuration are never dropped.
+///
+/// To wait for a publisher to be matched before the first write, use PublisherGate::WaitReady.
+///
+/// This is the blocking form of awaiting a sample: the repository targets C++14, which has
+/// no coroutines, so each inbox needs a thread of its own to wait on.
+class Inbox {
+public:
+   using Clock = std::chrono::steady_clock;
+
+   enum class Kind {
+      Tick,
+      SimulationControl,
+      ModuleConfiguration,
+
+      /// The wait timed out.
+      Timeout,
+
+      /// Stop was called and nothing is left queued.
+      Stopped
+   };
+
+   struct Event {
+      Kind kind;
+      AMM::Tick tick;
+      AMM::SimulationControl simulationControl;
+      AMM::ModuleConfiguration moduleConfiguration;
+   };
+
+   struct Stats {
+      std::uint64_t ticks;
+      std::uint64_t droppedTicks;
+      std::uint64_t simulationControls;
+      std::uint64_t moduleConfigurations;
+
+      /// Module Configurations for other modules, dropped on arrival.
+      std::uint64_t foreignConfigurations;
+   };
+
+   /// Only Module Configuration carrying *moduleId is kept. It is read on every sample, so it
+   /// may be set after the inbox is made, but must outlive the inbox and must not change while
+   /// samples arrive. It is taken by pointer so that requirement shows where it is passed.
+   explicit Inbox (const AMM::UUID* moduleId, std::size_t tickCapacity = 1024);
+
+   Inbox (const Inbox&) = delete;
+   Inbox& operator= (const Inbox&) = delete;
+
+   /// Called from subscriber callbacks, on any thread.
+   void OnTick (const AMM::Tick& tick);
+   void OnSimulationControl (const AMM::SimulationControl& simControl);
+   void OnModuleConfiguration (const AMM::ModuleConfiguration& modConfig);
+
+   /// Waits for the next input of any kind, at most timeout.
+   Event Next (Clock::duration timeout = Clock::duration::max());
+
+   /// Wait for the next input of one kind, at most timeout. Other inputs stay queued.
+   /// Return false on timeout or once stopped.
+   bool NextTick (AMM::Tick& tick, Clock::duration timeout = Clock::duration::max());
+   bool NextSimulationControl (AMM::SimulationControl& simControl, Clock::duration timeout = Clock::duration::max());
+   bool NextModuleConfiguration (AMM::ModuleConfiguration& modConfig, Clock::duration timeout = Clock::duration::max());
+
+   /// Wakes every waiter. Inputs already queued are still returned; after that, Next
+   /// returns Stopped and the typed waits return false.
+   void Stop ();
+
+   Stats GetStats () const;
+
+private:
+   /// Waits until ready() or stopped, at most timeout. Returns whether ready() holds.
+   template <typename Ready>
+   bool Wait (std::unique_lock<std::mutex>& lock, Clock::duration timeout, Ready ready);
+
+   const AMM::UUID* m_moduleId;
+   const std::size_t m_tickCapacity;
+
+   mutable std::mutex m_mutex;
+   std::condition_variable m_cv;
+   std::deque<AMM::Tick> m_ticks;
+   std::deque<AMM::SimulationControl> m_simulationControls;
+   std::deque<AMM::ModuleConfiguration> m_moduleConfigurations;
+   bool m_stopped = false;
+
+   Stats m_stats = Stats();
+};
+
+} // namespace Module
@@ -0,0 +1,177 @@
+#include "Module/Logger.h"
+
+#include <utility>
+
+namespace Module {
+
+namespace {
+
+const char* LevelName (AMM::LogLevel level) {
+   switch (level) {
+   case AMM::LogLevel::info :    return "INFO";
+   case AMM::LogLevel::warning : return "WARN";
+   case AMM::LogLevel::error :   return "ERROR";
+   case AMM::LogLevel::debug :   return "DEBUG";
+   }
+   return "";
+}
+
+long long Timestamp () {
+   using namespace std::chrono;
+   return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+Logger::Logger (Options options)
+   : m_options(std::move(options)), m_ring(m_options.capacity), m_file(nullptr),
+     m_stop(false), m_console(m_options.console ? stdout : nullptr), m_mgr(nullptr),
+     m_logged(0), m_dropped(0), m_written(0), m_batches(0), m_published(0) {
+   if (!m_options.file.empty()) m_file = std::fopen(m_options.file.c_str(), "a");
+   m_batch.reserve(m_ring.Capacity());
+   m_thread = std::thread([this]() { Run(); });
+}
+
+Logger::~Logger () {
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+   }
+   m_wake.notify_one();
+   m_thread.join();
+
+   if (m_file) std::fclose(m_file);
+}
+
+void Logger::Log (AMM::LogLevel level, std::string message) {
+   Record record{ level, Timestamp(), std::move(message) };
+   bool wake = false;
+
+   if (!m_ring.TryPush(record, wake)) {
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+   }
+   m_logged.fetch_add(1, std::memory_order_relaxed);
+
+   /// Lines are written in batches, so the writer is only woken early when the buffer
+   /// is half full. Otherwise it picks this line up at the next flush interval.
+   if (m_ring.Size() >= m_ring.Capacity() / 2) m_wake.notify_one();
+}
+
+void Logger::ConsoleTo (std::FILE* stream) {
+   std::lock_guard<std::mutex> lock(m_mutex);
+   m_console = stream;
+}
+
+void Logger::PublishTo (AMM::DDSManager<void>* mgr, const AMM::UUID& moduleId) {
+   std::lock_guard<std::mutex> lock(m_mutex);
+   m_mgr = mgr;
+   m_moduleId = moduleId;
+}
+
+void Logger::Flush () {
+   std::uint64_t target = m_logged.load();
+
+   std::unique_lock<std::mutex> lock(m_mutex);
+   m_wake.notify_one();
+   m_flushed.wait(lock, [&]() { return m_written.load() >= target || m_stop; });
+}
+
+Logger::Stats Logger::GetStats () const {
+   Stats stats;
+   stats.logged = m_logged.load(std::memory_order_relaxed);
+   stats.dropped = m_dropped.load(std::memory_order_relaxed);
+   stats.written = m_written.load(std::memory_order_relaxed);
+   stats.batches = m_batches.load(std::memory_order_relaxed);
+   stats.published = m_published.load(std::memory_order_relaxed);
+   return stats;
+}
+
+void Logger::Run () {
+   std::unique_lock<std::mutex> lock(m_mutex);
+   for (;;) {
+      /// Keep writing without waiting while loggers are filling the buffer.
+      if (m_ring.Size() < m_ring.Capacity() / 2) m_wake.wait_for(lock, m_options.flushInterval);
+      bool stop = m_stop;
+
+      lock.unlock();
+      WriteBatch();
+      lock.lock();
+
+      m_flushed.notify_all();
+      if (stop) break;
+   }
+}
+
+void Logger::WriteBatch () {
+   m_batch.clear();
+   m_text.clear();
+
+   Record record;
+   while (m_batch.size() < m_ring.Capacity() && m_ring.TryPop(record)) {
+      m_text += "[";
+      m_text += LevelName(record.level);
+      m_text += "] ";
+      m_text += record.message;
+      m_text += "\n";
+      m_batch.push_back(std::move(record));
+   }
+   if (m_batch.empty()) return;
+
+   std::FILE* console;
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      console = m_console;
+   }
+
+   /// One write and one flush per batch rather than per line.
+   if (console) {
+      std::fwrite(m_text.data(), 1, m_text.size(), console);
+      std::fflush(console);
+   }
+   if (m_file) {
+      std::fwrite(m_text.data(), 1, m_text.size(), m_file);
+      std::fflush(m_file);
+   }
+
+   std::size_t begin = 0;
+   for (std::size_t i = 1; i <= m_batch.size(); ++i) {
+      if (i == m_batch.size() || m_batch[i].level != m_batch[begin].level) {
+         Publish(begin, i);
+         begin = i;
+      }
+   }
+
+   m_batches.fetch_add(1, std::memory_order_relaxed);
+   m_written.fetch_add(m_batch.size());
+}
+
+void Logger::Publish (std::size_t begin, std::size_t end) {
+   AMM::DDSManager<void>* mgr;
+   AMM::Log log;
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      mgr = m_mgr;
+      log.module_id(m_moduleId);
+   }
+   if (!mgr) return;
+
+   std::string message;
+   for (std::size_t i = begin; i < end; ++i) {
+      if (i != begin) message += "\n";
+      message += m_batch[i].message;
+   }
+
+   log.timestamp(m_batch[begin].timestamp);
+   log.level(m_batch[begin].level);
+   log.message(message);
+   mgr->WriteLog(log);
+   m_published.fetch_add(1, std::memory_order_relaxed);
+}
+
+Logger& Log () {
+   static Logger logger(Logger::Options{});
+   return logger;
+}
+
+} // namespace Module
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <amm_std.h>
+
+#include "Module/HandoffQueue.h"
+
+namespace Module {
+
+/// Asynchronous, batched module log.
+///
+/// Logging from a subscriber callback with std::cout and std::endl flushes the stream for
+/// every sample, which holds up the listener thread for the length of a write call. A Logger
+/// instead takes a preformatted line into a lock-free ring buffer and returns. A background
+/// thread drains the buffer every flush interval, or sooner when it fills up, and writes the
+/// whole batch at once to the console and/or a file, optionally also publishing it as AMM Log.
+///
+/// Logging never blocks. If the buffer is full the line is dropped and counted.
+class Logger {
+public:
+   using Clock = std::chrono::steady_clock;
+
+   struct Options {
+      /// Lines held between batches. Rounded up to a power of two.
+      std::size_t capacity = 4096;
+
+      /// Longest time a line waits before it is written.
+      Clock::duration flushInterval = std::chrono::milliseconds(50);
+
+      /// Write to standard output.
+      bool console = true;
+
+      /// Also append to this file when not empty.
+      std::string file;
+   };
+
+   struct Stats {
+      std::uint64_t logged;
+      std::uint64_t dropped;
+      std::uint64_t written;
+      std::uint64_t batches;
+      std::uint64_t published;
+   };
+
+   explicit Logger (Options options);
+
+   /// Writes everything still buffered, then stops the background thread.
+   ~Logger ();
+
+   Logger (const Logger&) = delete;
+   Logger& operator= (const Logger&) = delete;
+
+   void Log (AMM::LogLevel level, std::string message);
+
+   void Info (std::string message)    { Log(AMM::LogLevel::info, std::move(message)); }
+   void Warning (std::string message) { Log(AMM::LogLevel::warning, std::move(message)); }
+   void Error (std::string message)   { Log(AMM::LogLevel::error, std::move(message)); }
+   void Debug (std::string message)   { Log(AMM::LogLevel::debug, std::move(message)); }
+
+   /// Writes console output to stream from the next batch on, or nowhere for nullptr.
+   /// Tools that print their own results on standard output send the log to stderr.
+   void ConsoleTo (std::FILE* stream);
+
+   /// Also publishes each batch as AMM Log samples, one per run of lines with the same level.
+   /// Log must already be initialized with a publisher on mgr. Pass nullptr to stop.
+   void PublishTo (AMM::DDSManager<void>* mgr, const AMM::UUID& moduleId);
+
+   /// Blocks until every line logged before the call has been written.
+   void Flush ();
+
+   Stats GetStats () const;
+
+private:
+   struct Record {
+      AMM::LogLevel level;
+      long long timestamp;
+      std::string message;
+   };
+
+   void Run ();
+   void WriteBatch ();
+   void Publish (std::size_t begin, std::size_t end);
+
+   Options m_options;
+   RingBuffer<Record> m_ring;
+   std::FILE* m_file;
+
+   std::mutex m_mutex;
+   std::condition_variable m_wake;
+   std::condition_variable m_flushed;
+   bool m_stop;
+
+   std::FILE* m_console;
+   AMM::DDSManager<void>* m_mgr;
+   AMM::UUID m_moduleId;
+
+   /// Used by the background thread only.
+   std::vector<Record> m_batch;
+   std::string m_text;
+
+   std::atomic<std::uint64_t> m_logged;
+   std::atomic<std::uint64_t> m_dropped;
+   std::atomic<std::uint64_t> m_written;
+   std::atomic<std::uint64_t> m_batches;
+   std::atomic<std::uint64_t> m_published;
+
+   std::thread m_thread;
+};
+
+/// Logger shared by the example module and tutorials, writing to the console.
+Logger& Log ();
+
+} // namespace Module
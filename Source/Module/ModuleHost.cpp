@@ -0,0 +1,157 @@
+#include "Module/ModuleHost.h"
+
+#include <chrono>
+#include <utility>
+
+namespace Module {
+
+namespace {
+
+/// The host DDS Manager callbacks deliver to. Cleared before the host is destroyed, so a
+/// sample arriving during teardown is dropped rather than delivered to a dead host.
+std::atomic<ModuleHost*> activeHost(nullptr);
+
+/// Operational Description and Status only carry each module's latest value, so re-sending
+/// them until the publishers match is harmless.
+PublisherGate::Options GateOptions () {
+   PublisherGate::Options options;
+   options.resendInterval = std::chrono::milliseconds(25);
+   return options;
+}
+
+} // namespace
+
+const ModuleHost::Handle ModuleHost::NoModule;
+
+ModuleHost::ModuleHost (Participant& participant, RunLoop& loop)
+   : m_participant(participant),
+     m_descriptionGate(loop, GateOptions()), m_statusGate(loop, GateOptions()),
+     m_started(false),
+     m_simulationControls(0), m_moduleConfigurations(0), m_foreignConfigurations(0), m_ticks(0) {
+   auto* mgr = m_participant.Get();
+
+   m_participant.Use([mgr]() { return mgr->InitializeOperationalDescription(); },
+                     [mgr]() { mgr->DecommissionOperationalDescription(); });
+   m_participant.Use([mgr]() { return mgr->InitializeStatus(); },
+                     [mgr]() { mgr->DecommissionStatus(); });
+   m_participant.Use([mgr]() { return mgr->InitializeSimulationControl(); },
+                     [mgr]() { mgr->DecommissionSimulationControl(); });
+   m_participant.Use([mgr]() { return mgr->InitializeModuleConfiguration(); },
+                     [mgr]() { mgr->DecommissionModuleConfiguration(); });
+   m_participant.Use([mgr]() { return mgr->InitializeTick(); },
+                     [mgr]() { mgr->DecommissionTick(); });
+
+   mgr->CreateOperationalDescriptionPublisher();
+   mgr->CreateStatusPublisher();
+}
+
+ModuleHost::~ModuleHost () {
+   ModuleHost* self = this;
+   activeHost.compare_exchange_strong(self, nullptr);
+}
+
+ModuleHost::Handle ModuleHost::Add (const AMM::OperationalDescription& description, Callbacks callbacks) {
+   if (m_started) return NoModule;
+
+   const std::string& id = description.module_id().id();
+   if (id.empty() || m_byId.count(id) != 0) return NoModule;
+
+   Handle handle = m_modules.size();
+   m_modules.push_back(Hosted{ description, std::move(callbacks) });
+   m_byId.emplace(id, handle);
+
+   WriteOperationalDescription(handle);
+   return handle;
+}
+
+int ModuleHost::Start () {
+   if (m_started) return 0;
+
+   ModuleHost* none = nullptr;
+   if (!activeHost.compare_exchange_strong(none, this)) return 1;
+   m_started = true;
+
+   auto* mgr = m_participant.Get();
+   mgr->CreateSimulationControlSubscriber(&ModuleHost::OnSimulationControl);
+   mgr->CreateModuleConfigurationSubscriber(&ModuleHost::OnModuleConfiguration);
+   mgr->CreateTickSubscriber(&ModuleHost::OnTick);
+   return 0;
+}
+
+int ModuleHost::WriteStatus (Handle module, AMM::Status& status) {
+   if (module >= m_modules.size()) return 1;
+
+   const Hosted& hosted = m_modules[module];
+   status.module_id(hosted.description.module_id());
+   status.module_name(hosted.description.name());
+
+   auto* mgr = m_participant.Get();
+   return m_statusGate.Write([mgr, status]() mutable { return mgr->WriteStatus(status); });
+}
+
+int ModuleHost::WriteOperationalDescription (Handle module) {
+   if (module >= m_modules.size()) return 1;
+
+   auto* mgr = m_participant.Get();
+   AMM::OperationalDescription description = m_modules[module].description;
+   return m_descriptionGate.Write([mgr, description]() mutable {
+      return mgr->WriteOperationalDescription(description);
+   });
+}
+
+int ModuleHost::ModuleId (Handle module, AMM::UUID& id) const {
+   if (module >= m_modules.size()) return 1;
+   id = m_modules[module].description.module_id();
+   return 0;
+}
+
+std::size_t ModuleHost::Size () const {
+   return m_modules.size();
+}
+
+ModuleHost::Stats ModuleHost::GetStats () const {
+   Stats stats;
+   stats.modules = m_modules.size();
+   stats.simulationControls = m_simulationControls.load(std::memory_order_relaxed);
+   stats.moduleConfigurations = m_moduleConfigurations.load(std::memory_order_relaxed);
+   stats.foreignConfigurations = m_foreignConfigurations.load(std::memory_order_relaxed);
+   stats.ticks = m_ticks.load(std::memory_order_relaxed);
+   return stats;
+}
+
+void ModuleHost::OnSimulationControl (AMM::SimulationControl& simControl, eprosima::fastrtps::SampleInfo_t* info) {
+   ModuleHost* host = activeHost.load();
+   if (host == nullptr) return;
+
+   host->m_simulationControls.fetch_add(1, std::memory_order_relaxed);
+   for (auto& hosted : host->m_modules) {
+      if (hosted.callbacks.simulationControl) hosted.callbacks.simulationControl(simControl);
+   }
+}
+
+void ModuleHost::OnModuleConfiguration (AMM::ModuleConfiguration& modConfig, eprosima::fastrtps::SampleInfo_t* info) {
+   ModuleHost* host = activeHost.load();
+   if (host == nullptr) return;
+
+   auto it = host->m_byId.find(modConfig.module_id().id());
+   if (it == host->m_byId.end()) {
+      host->m_foreignConfigurations.fetch_add(1, std::memory_order_relaxed);
+      return;
+   }
+
+   host->m_moduleConfigurations.fetch_add(1, std::memory_order_relaxed);
+   auto& callback = host->m_modules[it->second].callbacks.moduleConfiguration;
+   if (callback) callback(modConfig);
+}
+
+void ModuleHost::OnTick (AMM::Tick& tick, eprosima::fastrtps::SampleInfo_t* info) {
+   ModuleHost* host = activeHost.load();
+   if (host == nullptr) return;
+
+   host->m_ticks.fetch_add(1, std::memory_order_relaxed);
+   for (auto& hosted : host->m_modules) {
+      if (hosted.callbacks.tick) hosted.callbacks.tick(tick);
+   }
+}
+
+} // namespace Module
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <amm_std.h>
+
+#include "Module/Participant.h"
+#include "Module/PublisherGate.h"
+#include "Module/RunLoop.h"
+
+namespace Module {
+
+/// Hosts several logical modules on one participant.
+///
+/// Each DDS Manager is a participant of its own, with its own discovery traffic and
+/// FastRTPS threads, so the Tutorial 4 pattern of one DDS Manager per object multiplies
+/// all of that by the number of objects. A host instead initializes the module topics
+/// once, on one Participant, and fans samples out to every logical module it hosts. Each
+/// module keeps its own Module ID, Operational Description and Status.
+///
+///    Module::ModuleHost host(participant, loop);
+///    auto pump = host.Add(pumpDescription, pumpCallbacks);
+///    auto valve = host.Add(valveDescription, valveCallbacks);
+///    if (host.Start() != 0) { /* another host is running */ }
+///    host.WriteStatus(pump, status);
+///
+/// Simulation Control and Tick go to every module. Module Configuration goes only to the
+/// module whose ID it carries, found with one hash lookup; the rest are counted and dropped.
+/// Callbacks run on FastRTPS listener threads, as with DDS Manager itself, so modules with
+/// real work to do should hand samples to a RunLoop.
+///
+/// Operational Description and Status writes go through a PublisherGate on loop, so the ones
+/// made before the publishers have matched are re-sent rather than lost.
+///
+/// DDS Manager callbacks are plain functions, so only one host can be started at a time.
+/// Close the participant before destroying its host, so no callback is still running, and
+/// destroy it while loop is not running.
+class ModuleHost {
+public:
+   using Handle = std::size_t;
+
+   /// Returned by Add when the module could not be added.
+   static const Handle NoModule = static_cast<Handle>(-1);
+
+   /// Any callback may be left empty.
+   struct Callbacks {
+      std::function<void(AMM::SimulationControl&)> simulationControl;
+      std::function<void(AMM::ModuleConfiguration&)> moduleConfiguration;
+      std::function<void(AMM::Tick&)> tick;
+   };
+
+   struct Stats {
+      std::size_t modules;
+      std::uint64_t simulationControls;
+      std::uint64_t moduleConfigurations;
+
+      /// Module Configurations for modules this host does not have.
+      std::uint64_t foreignConfigurations;
+
+      std::uint64_t ticks;
+   };
+
+   /// Initializes the shared topics on participant. Their cleanup is registered with the
+   /// participant, so closing it ends the host's session. Writes are gated on loop.
+   ModuleHost (Participant& participant, RunLoop& loop);
+   ~ModuleHost ();
+
+   ModuleHost (const ModuleHost&) = delete;
+   ModuleHost& operator= (const ModuleHost&) = delete;
+
+   /// Adds a logical module and publishes its Operational Description.
+   /// description.module_id must be set and unique within the host. Returns NoModule if it
+   /// is not, or if the host has already started.
+   Handle Add (const AMM::OperationalDescription& description, Callbacks callbacks);
+
+   /// Creates the shared subscribers. Samples are fanned out from here on, and the set of
+   /// modules is fixed, so callbacks read it without locking.
+   /// Returns 1 if another host is already started, since callbacks can only reach one.
+   int Start ();
+
+   /// Writes status for one module, filling in its Module ID and name.
+   /// Returns the DDS Manager error code, 0 if the write was buffered by the gate, or 1 if
+   /// the handle is not one of this host's modules.
+   int WriteStatus (Handle module, AMM::Status& status);
+
+   /// Writes a module's Operational Description again, e.g. after a RESET.
+   /// Returns the same codes as WriteStatus.
+   int WriteOperationalDescription (Handle module);
+
+   /// Copies a module's ID into id. Returns 1 if the handle is not one of this host's modules.
+   int ModuleId (Handle module, AMM::UUID& id) const;
+
+   std::size_t Size () const;
+
+   Stats GetStats () const;
+
+private:
+   struct Hosted {
+      AMM::OperationalDescription description;
+      Callbacks callbacks;
+   };
+
+   static void OnSimulationControl (AMM::SimulationControl& simControl, eprosima::fastrtps::SampleInfo_t* info);
+   static void OnModuleConfiguration (AMM::ModuleConfiguration& modConfig, eprosima::fastrtps::SampleInfo_t* info);
+   static void OnTick (AMM::Tick& tick, eprosima::fastrtps::SampleInfo_t* info);
+
+   Participant& m_participant;
+   PublisherGate m_descriptionGate;
+   PublisherGate m_statusGate;
+   std::vector<Hosted> m_modules;
+   std::unordered_map<std::string, Handle> m_byId;
+   bool m_started;
+
+   std::atomic<std::uint64_t> m_simulationControls;
+   std::atomic<std::uint64_t> m_moduleConfigurations;
+   std::atomic<std::uint64_t> m_foreignConfigurations;
+   std::atomic<std::uint64_t> m_ticks;
+};
+
+} // namespace Module
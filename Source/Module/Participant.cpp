@@ -0,0 +1,45 @@
+#include "Module/Participant.h"
+
+#include <utility>
+
+namespace Module {
+
+Participant::Participant (const std::string& configFile)
+   : m_mgr(new Manager(configFile)) {
+}
+
+Participant::~Participant () {
+   Close();
+   m_mgr->Shutdown();
+   delete m_mgr;
+}
+
+void Participant::OnClose (std::function<void()> cleanup) {
+   std::lock_guard<std::mutex> lock(m_mutex);
+   m_cleanup.push_back(std::move(cleanup));
+}
+
+int Participant::Use (const std::function<int()>& initialize, std::function<void()> decommission) {
+   int result = initialize();
+   if (result == 0) OnClose(std::move(decommission));
+   return result;
+}
+
+void Participant::Close () {
+   std::vector<std::function<void()>> cleanup;
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      cleanup.swap(m_cleanup);
+      m_sessions++;
+   }
+
+   /// Outside the lock, so a cleanup may register for the next session.
+   for (auto it = cleanup.rbegin(); it != cleanup.rend(); ++it) (*it)();
+}
+
+std::uint64_t Participant::Sessions () const {
+   std::lock_guard<std::mutex> lock(m_mutex);
+   return m_sessions;
+}
+
+} // namespace Module
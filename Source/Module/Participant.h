@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <amm_std.h>
+
+namespace Module {
+
+/// Owns one DDS Manager, and so one DDS Participant, for the life of the process.
+///
+/// Once Shutdown has been called on any DDS Manager, DDS Managers created later in the same
+/// process can no longer publish or subscribe (see ExampleModule.cpp). Creating a participant
+/// also costs seconds of discovery. A Participant avoids both by never shutting down between
+/// scenarios: topics are initialized for a session and decommissioned when the session is
+/// closed, while the participant itself stays up and stays discovered.
+///
+///    mgr->InitializeAssessment();
+///    participant.OnClose([mgr]() { mgr->DecommissionAssessment(); });
+///    ...
+///    participant.Close();   // pause: all topics removed, participant kept
+///
+/// A closed participant is paused; initializing topics again resumes it. The destructor
+/// closes the session and shuts the DDS Manager down, so create one Participant up front
+/// and destroy it only when the program is about to exit.
+class Participant {
+public:
+   using Manager = AMM::DDSManager<void>;
+
+   explicit Participant (const std::string& configFile);
+   ~Participant ();
+
+   Participant (const Participant&) = delete;
+   Participant& operator= (const Participant&) = delete;
+
+   Manager* Get () const { return m_mgr; }
+   Manager* operator-> () const { return m_mgr; }
+
+   /// Registers cleanup for something set up on the DDS Manager during this session,
+   /// usually Decommission for an initialized type. Close runs these in reverse order.
+   void OnClose (std::function<void()> cleanup);
+
+   /// Initializes a type for this session and registers its cleanup if that succeeded.
+   /// Returns the DDS Manager error code from initialize.
+   int Use (const std::function<int()>& initialize, std::function<void()> decommission);
+
+   /// Ends the session by running every registered cleanup. The participant stays up.
+   void Close ();
+
+   /// Number of sessions closed so far.
+   std::uint64_t Sessions () const;
+
+private:
+   Manager* m_mgr;
+
+   mutable std::mutex m_mutex;
+   std::vector<std::function<void()>> m_cleanup;
+   std::uint64_t m_sessions = 0;
+};
+
+} // namespace Module
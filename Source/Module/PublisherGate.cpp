@@ -0,0 +1,135 @@
+#include "Module/PublisherGate.h"
+
+#include <utility>
+#include <vector>
+
+namespace Module {
+
+PublisherGate::PublisherGate (RunLoop& loop, Options options)
+   : m_loop(loop), m_options(options), m_resendInterval(options.resendInterval),
+     m_created(Clock::now()) {
+   m_loop.PostAfter(m_options.deadline, [this]() { Open(true); }, this);
+}
+
+PublisherGate::~PublisherGate () {
+   m_loop.Cancel(this);
+}
+
+int PublisherGate::Write (WriteFn write) {
+   std::unique_lock<std::mutex> lock(m_mutex);
+
+   /// Writes made after the gate opened still wait behind a pending flush,
+   /// so samples always go out in the order they were written.
+   if (m_state == State::Open && m_buffer.empty()) {
+      lock.unlock();
+      return Send(write);
+   }
+
+   if (m_buffer.size() >= m_options.maxBuffered) {
+      m_buffer.pop_front();
+      m_dropped++;
+   }
+
+   bool resending = m_state == State::Pending && m_resendInterval != Clock::duration::zero();
+   m_buffer.push_back(Pending{ write, resending });
+
+   if (resending) {
+      bool schedule = !m_resendScheduled;
+      m_resendScheduled = true;
+      lock.unlock();
+
+      /// Best effort: if a reader already matched, this is the write it gets.
+      Send(write);
+      if (schedule) m_loop.PostAfter(m_resendInterval, [this]() { Resend(); }, this);
+   }
+   return 0;
+}
+
+void PublisherGate::OnPublicationMatched (int matchedReaders) {
+   if (matchedReaders > 0) Open(false);
+}
+
+void PublisherGate::MarkMatched () {
+   Open(false);
+}
+
+bool PublisherGate::IsReady () const {
+   std::lock_guard<std::mutex> lock(m_mutex);
+   return m_state == State::Open;
+}
+
+bool PublisherGate::WaitReady (Clock::duration timeout) {
+   std::unique_lock<std::mutex> lock(m_mutex);
+   return m_cv.wait_for(lock, timeout, [this]() { return m_state == State::Open; });
+}
+
+PublisherGate::Stats PublisherGate::GetStats () const {
+   std::lock_guard<std::mutex> lock(m_mutex);
+   Stats stats;
+   stats.timeToReady = m_state == State::Open ? m_ready - m_created : Clock::duration::zero();
+   stats.timeToFirstWrite = m_writes > 0 ? m_firstWrite - m_created : Clock::duration::zero();
+   stats.openedByDeadline = m_openedByDeadline;
+   stats.writes = m_writes;
+   stats.resends = m_resends;
+   stats.dropped = m_dropped;
+   return stats;
+}
+
+void PublisherGate::Open (bool byDeadline) {
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_state == State::Open) return;
+      m_state = State::Open;
+      m_ready = Clock::now();
+      m_openedByDeadline = byDeadline;
+   }
+   m_cv.notify_all();
+   m_loop.Post([this]() { Flush(); }, this);
+}
+
+void PublisherGate::Flush () {
+   std::unique_lock<std::mutex> lock(m_mutex);
+   while (!m_buffer.empty()) {
+      Pending pending = std::move(m_buffer.front());
+      m_buffer.pop_front();
+
+      /// Already went out while the gate was waiting; sending it again would only repeat it.
+      if (pending.sent) continue;
+
+      lock.unlock();
+      Send(pending.write);
+      lock.lock();
+   }
+}
+
+void PublisherGate::Resend () {
+   std::unique_lock<std::mutex> lock(m_mutex);
+   if (m_state == State::Open) {
+      m_resendScheduled = false;
+      return;
+   }
+
+   std::vector<WriteFn> pending;
+   pending.reserve(m_buffer.size());
+   for (auto& entry : m_buffer) {
+      pending.push_back(entry.write);
+      entry.sent = true;
+   }
+   m_resends += pending.size();
+   m_resendInterval *= 2;
+   Clock::duration next = m_resendInterval;
+   lock.unlock();
+
+   for (auto& write : pending) Send(write);
+   m_loop.PostAfter(next, [this]() { Resend(); }, this);
+}
+
+int PublisherGate::Send (const WriteFn& write) {
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_writes++ == 0) m_firstWrite = Clock::now();
+   }
+   return write();
+}
+
+} // namespace Module
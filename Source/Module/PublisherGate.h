@@ -0,0 +1,124 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+#include "Module/RunLoop.h"
+
+namespace Module {
+
+/// Holds back writes to one DDS Manager publisher until it is ready to deliver them.
+///
+/// A freshly created publisher silently drops writes until FastRTPS has matched it with
+/// remote readers, which is why the tutorials sleep before their first write. A gate
+/// replaces the fixed sleep: writes made before the publisher is ready are buffered and
+/// flushed once it is, and WaitReady lets callers block until then or until a deadline.
+///
+/// The gate becomes ready when OnPublicationMatched reports at least one reader (wire this
+/// to a FastRTPS PublisherListener, or call MarkMatched when a reply proves a reader is
+/// listening), or when the deadline passes. DDS Manager does not report matches itself,
+/// so for topics where repeating the latest sample is harmless (Operational Description,
+/// Module Configuration, Status) the gate can also re-send pending writes with a doubling
+/// back-off until it is ready. Whichever resend lands after discovery is the one delivered.
+/// Writes that already went out this way are not sent again when the gate opens.
+///
+/// Timers run on the given RunLoop. The gate must outlive that loop's Run call.
+class PublisherGate {
+public:
+   using Clock = RunLoop::Clock;
+
+   /// Performs the actual DDS Manager write, e.g. mgr->WriteStatus(status).
+   /// Returns the DDS Manager error code.
+   using WriteFn = std::function<int()>;
+
+   struct Options {
+      /// Longest time writes are held back. When it passes the gate opens anyway.
+      Clock::duration deadline = std::chrono::seconds(2);
+
+      /// First resend interval while waiting. Zero disables resending.
+      Clock::duration resendInterval = Clock::duration::zero();
+
+      /// Writes buffered while waiting. The oldest is dropped when full.
+      std::size_t maxBuffered = 16;
+   };
+
+   PublisherGate (RunLoop& loop, Options options);
+
+   /// Cancels the pending deadline, resend and flush. Destroy on the loop thread or while
+   /// it is not running.
+   ~PublisherGate ();
+
+   PublisherGate (const PublisherGate&) = delete;
+   PublisherGate& operator= (const PublisherGate&) = delete;
+
+   /// Writes now if the gate is open, otherwise buffers the write.
+   /// Returns the write's result when written immediately and 0 when buffered.
+   int Write (WriteFn write);
+
+   /// Number of matched readers as reported by a publisher listener.
+   void OnPublicationMatched (int matchedReaders);
+
+   /// Opens the gate as if a reader had matched.
+   void MarkMatched ();
+
+   bool IsReady () const;
+
+   /// Blocks until the gate opens or the timeout passes. Returns IsReady.
+   bool WaitReady (Clock::duration timeout);
+
+   /// Startup figures for this publisher.
+   struct Stats {
+      /// Time from construction until the gate opened. Zero while still closed.
+      Clock::duration timeToReady;
+
+      /// Time from construction until the first write reached DDS Manager.
+      Clock::duration timeToFirstWrite;
+
+      bool openedByDeadline;
+      std::uint64_t writes;
+      std::uint64_t resends;
+      std::uint64_t dropped;
+   };
+
+   Stats GetStats () const;
+
+private:
+   enum class State { Pending, Open };
+
+   struct Pending {
+      WriteFn write;
+
+      /// Sent at least once while the gate was waiting, so the flush on open skips it.
+      bool sent;
+   };
+
+   void Open (bool byDeadline);
+   void Flush ();
+   void Resend ();
+   int Send (const WriteFn& write);
+
+   RunLoop& m_loop;
+   Options m_options;
+
+   mutable std::mutex m_mutex;
+   std::condition_variable m_cv;
+   State m_state = State::Pending;
+   std::deque<Pending> m_buffer;
+   Clock::duration m_resendInterval;
+   bool m_resendScheduled = false;
+
+   Clock::time_point m_created;
+   Clock::time_point m_ready;
+   Clock::time_point m_firstWrite;
+   bool m_openedByDeadline = false;
+   std::uint64_t m_writes = 0;
+   std::uint64_t m_resends = 0;
+   std::uint64_t m_dropped = 0;
+};
+
+} // namespace Module
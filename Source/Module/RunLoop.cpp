@@ -0,0 +1,163 @@
+#include "Module/RunLoop.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace Module {
+
+RunLoop::RunLoop ()
+   : m_running(false), m_wakeups(0) {
+}
+
+RunLoop::~RunLoop () {
+   Stop();
+}
+
+void RunLoop::Run () {
+   std::unique_lock<std::mutex> lock(m_mutex);
+   m_running = true;
+
+   std::deque<Entry> tasks;
+
+   while (!m_stopped) {
+
+      /// Move every timer that has come due onto the task queue.
+      auto now = Clock::now();
+      while (!m_timers.empty() && m_timers.front().due <= now) {
+         std::pop_heap(m_timers.begin(), m_timers.end(), TimerLater());
+         Timer timer = std::move(m_timers.back());
+         m_timers.pop_back();
+
+         if (timer.period != Clock::duration::zero()) {
+            /// Reschedule from the previous deadline so the period does not drift,
+            /// but never schedule in the past if the loop fell behind.
+            Clock::time_point next = timer.due + timer.period;
+            if (next <= now) next = now + timer.period;
+            AddTimer(next, timer.period, timer.task, timer.owner);
+         }
+         m_tasks.push_back(Entry{ std::move(timer.task), timer.owner });
+      }
+
+      if (m_tasks.empty() && !m_notified) {
+         if (m_timers.empty()) {
+            m_cv.wait(lock);
+         } else {
+            m_cv.wait_until(lock, m_timers.front().due);
+         }
+         m_wakeups++;
+         continue;
+      }
+
+      m_notified = false;
+      tasks.swap(m_tasks);
+      lock.unlock();
+
+      for (auto& handler : m_wakeHandlers) handler.task();
+      for (auto& entry : tasks) {
+         if (entry.owner != nullptr && !m_cancelledInBatch.empty()
+             && std::find(m_cancelledInBatch.begin(), m_cancelledInBatch.end(), entry.owner) != m_cancelledInBatch.end()) {
+            continue;
+         }
+         entry.task();
+         ServiceControl();
+      }
+
+      /// Cleared rather than destroyed, so the next wake-up reuses its storage.
+      tasks.clear();
+      m_cancelledInBatch.clear();
+      lock.lock();
+   }
+
+   /// Ready for the next Run.
+   m_stopped = false;
+   m_running = false;
+}
+
+void RunLoop::Stop () {
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stopped = true;
+      m_tasks.clear();
+      m_timers.clear();
+   }
+   m_cv.notify_all();
+}
+
+void RunLoop::Post (Task task, Owner owner) {
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_tasks.push_back(Entry{ std::move(task), owner });
+   }
+   m_cv.notify_one();
+}
+
+void RunLoop::PostAfter (Clock::duration delay, Task task, Owner owner) {
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      AddTimer(Clock::now() + delay, Clock::duration::zero(), std::move(task), owner);
+   }
+   m_cv.notify_one();
+}
+
+void RunLoop::PostEvery (Clock::duration period, Task task, Owner owner) {
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      AddTimer(Clock::now() + period, period, std::move(task), owner);
+   }
+   m_cv.notify_one();
+}
+
+void RunLoop::Cancel (Owner owner) {
+   if (owner == nullptr) return;
+
+   std::lock_guard<std::mutex> lock(m_mutex);
+   auto owned = [owner](const Entry& entry) { return entry.owner == owner; };
+   m_tasks.erase(std::remove_if(m_tasks.begin(), m_tasks.end(), owned), m_tasks.end());
+
+   auto ownedTimer = [owner](const Timer& timer) { return timer.owner == owner; };
+   m_timers.erase(std::remove_if(m_timers.begin(), m_timers.end(), ownedTimer), m_timers.end());
+   std::make_heap(m_timers.begin(), m_timers.end(), TimerLater());
+
+   auto ownedHandler = [owner](const WakeHandler& handler) { return handler.owner == owner; };
+   m_wakeHandlers.erase(std::remove_if(m_wakeHandlers.begin(), m_wakeHandlers.end(), ownedHandler), m_wakeHandlers.end());
+   m_controlHandlers.erase(std::remove_if(m_controlHandlers.begin(), m_controlHandlers.end(), ownedHandler), m_controlHandlers.end());
+
+   if (m_running) m_cancelledInBatch.push_back(owner);
+}
+
+void RunLoop::Notify () {
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_notified = true;
+   }
+   m_cv.notify_one();
+}
+
+void RunLoop::AddWakeHandler (Task task, Priority priority, Owner owner) {
+   std::lock_guard<std::mutex> lock(m_mutex);
+   if (priority == Priority::Control) m_controlHandlers.push_back(WakeHandler{ priority, task, owner });
+
+   /// Keep handlers sorted by priority, in registration order within one priority.
+   auto it = m_wakeHandlers.begin();
+   while (it != m_wakeHandlers.end() && it->priority <= priority) ++it;
+   m_wakeHandlers.insert(it, WakeHandler{ priority, std::move(task), owner });
+}
+
+void RunLoop::ServiceControl () {
+   for (auto& handler : m_controlHandlers) handler.task();
+}
+
+bool RunLoop::IsRunning () const {
+   return m_running;
+}
+
+std::uint64_t RunLoop::Wakeups () const {
+   return m_wakeups;
+}
+
+void RunLoop::AddTimer (Clock::time_point due, Clock::duration period, Task task, Owner owner) {
+   m_timers.push_back(Timer{ due, period, m_timerSeq++, std::move(task), owner });
+   std::push_heap(m_timers.begin(), m_timers.end(), TimerLater());
+}
+
+} // namespace Module
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Module {
+
+/// Blocking run loop for a module's non-AMM execution thread.
+///
+/// The thread calling Run sleeps on a condition variable and only wakes when work is
+/// posted, when a timer comes due, or when Stop is called. This replaces the busy-spin
+/// "keep alive" loops, which held one core at 100% while doing nothing.
+///
+/// Post, PostAfter, PostEvery and Stop may be called from any thread, including
+/// DDS Manager subscriber callbacks. Tasks always run on the thread that called Run.
+///
+/// A loop can be run again after Run returns. Objects that post work capturing this pass
+/// themselves as the owner and call Cancel before they are destroyed, so nothing left
+/// queued can call into them afterwards.
+class RunLoop {
+public:
+   using Clock = std::chrono::steady_clock;
+   using Task = std::function<void()>;
+
+   /// Identifies who queued a task, timer or wake handler. Usually the object's this pointer.
+   using Owner = const void*;
+
+   /// Order in which wake handlers run.
+   /// Control is for topics a module must act on promptly whatever else is arriving, like
+   /// Simulation Control. Bulk is for high-volume data, like waveforms.
+   enum class Priority { Control, Normal, Bulk };
+
+   RunLoop ();
+   ~RunLoop ();
+
+   RunLoop (const RunLoop&) = delete;
+   RunLoop& operator= (const RunLoop&) = delete;
+
+   /// Executes posted tasks and timers until Stop is called.
+   /// Once Run returns the loop can be run again.
+   void Run ();
+
+   /// Wakes the loop and makes Run return. Tasks and timers still queued are discarded;
+   /// wake handlers stay registered.
+   /// Safe to call before Run, in which case the next Run returns immediately.
+   void Stop ();
+
+   /// Queues a task to run as soon as possible.
+   void Post (Task task, Owner owner = nullptr);
+
+   /// Queues a task to run once after a delay.
+   void PostAfter (Clock::duration delay, Task task, Owner owner = nullptr);
+
+   /// Queues a task to run repeatedly with a fixed period until the loop stops.
+   /// Missed periods are skipped rather than run back to back.
+   void PostEvery (Clock::duration period, Task task, Owner owner = nullptr);
+
+   /// Removes every task, timer and wake handler queued by owner.
+   /// Call on the loop thread, or while the loop is not running, and not from a wake handler.
+   void Cancel (Owner owner);
+
+   /// Wakes the loop without queuing a task.
+   /// Used by producers that hand off work through their own queues.
+   void Notify ();
+
+   /// Registers a task that runs on every wake-up, before queued tasks.
+   /// Handlers run in priority order, and Control handlers also run between queued tasks.
+   /// Only call this before Run.
+   void AddWakeHandler (Task task, Priority priority = Priority::Normal, Owner owner = nullptr);
+
+   /// Runs the Control wake handlers now. Long running work on the loop thread, such as a
+   /// lower priority HandoffQueue draining a backlog, calls this between items so control
+   /// work never waits behind it. Only call this on the loop thread.
+   void ServiceControl ();
+
+   bool IsRunning () const;
+
+   /// Number of times the loop thread woke up. Idle loops should not move this.
+   std::uint64_t Wakeups () const;
+
+private:
+   struct Entry {
+      Task task;
+      Owner owner;
+   };
+
+   struct Timer {
+      Clock::time_point due;
+      Clock::duration period;
+      std::uint64_t seq;
+      Task task;
+      Owner owner;
+   };
+
+   struct TimerLater {
+      bool operator() (const Timer& a, const Timer& b) const {
+         return a.due != b.due ? a.due > b.due : a.seq > b.seq;
+      }
+   };
+
+   struct WakeHandler {
+      Priority priority;
+      Task task;
+      Owner owner;
+   };
+
+   void AddTimer (Clock::time_point due, Clock::duration period, Task task, Owner owner);
+
+   mutable std::mutex m_mutex;
+   std::condition_variable m_cv;
+   std::deque<Entry> m_tasks;
+
+   /// Binary heap ordered by TimerLater, kept in a vector so Cancel can remove from it.
+   std::vector<Timer> m_timers;
+
+   std::vector<WakeHandler> m_wakeHandlers;
+   std::vector<WakeHandler> m_controlHandlers;
+
+   /// Owners cancelled on the loop thread while it runs a batch of tasks, so tasks of theirs
+   /// already taken from the queue are skipped too.
+   std::vector<Owner> m_cancelledInBatch;
+
+   std::uint64_t m_timerSeq = 0;
+   bool m_notified = false;
+   bool m_stopped = false;
+   std::atomic<bool> m_running;
+   std::atomic<std::uint64_t> m_wakeups;
+};
+
+} // namespace Module
@@ -0,0 +1,69 @@
+#include "Module/SimClock.h"
+
+#include <algorithm>
+
+namespace Module {
+
+namespace {
+
+/// Ten seconds in nanoseconds. Intervals longer than this are clamped.
+const std::uint64_t highestInterval = 10ull * 1000 * 1000 * 1000;
+
+}
+
+SimClock::SimClock (Options options)
+   : m_options(options),
+     m_stats{ 0, 0, 0, 0, 0, 0, Metrics::Histogram(highestInterval), Metrics::Histogram(highestInterval) },
+     m_started(false) {
+}
+
+SimClock::Advance SimClock::OnTick (std::int64_t frame, float timeDilation, Clock::time_point arrived) {
+   double period = std::chrono::duration<double>(m_options.period).count();
+
+   std::lock_guard<std::mutex> lock(m_mutex);
+   m_stats.ticks++;
+
+   Advance advance{ 0, period * timeDilation, 0, 0.0 };
+
+   /// Sim Manager starts again from frame 1 when it restarts, so that is not a duplicate.
+   if (m_started && frame <= m_stats.lastFrame && frame > 1) {
+      m_stats.duplicates++;
+      return advance;
+   }
+
+   std::int64_t elapsed = m_started && frame > m_stats.lastFrame ? frame - m_stats.lastFrame : 1;
+   advance.missed = elapsed - 1;
+
+   if (m_started) {
+      auto interval = std::chrono::duration_cast<std::chrono::nanoseconds>(arrived - m_lastArrival).count();
+      auto due = std::chrono::duration_cast<std::chrono::nanoseconds>(m_options.period * elapsed).count();
+      m_stats.interval.Record(static_cast<std::uint64_t>(std::max<long long>(interval, 0) / elapsed));
+      m_stats.jitter.Record(static_cast<std::uint64_t>(interval > due ? interval - due : due - interval));
+   }
+
+   if (advance.missed > 0) {
+      m_stats.gaps++;
+      m_stats.missedFrames += static_cast<std::uint64_t>(advance.missed);
+   }
+
+   if (m_options.catchUp == CatchUp::RunMissed) {
+      advance.steps = static_cast<std::uint32_t>(std::min<std::int64_t>(elapsed, m_options.maxCatchUpSteps));
+   } else {
+      advance.steps = 1;
+   }
+   m_stats.skippedSteps += static_cast<std::uint64_t>(elapsed - advance.steps);
+
+   advance.seconds = elapsed * advance.stepSeconds;
+
+   m_stats.lastFrame = frame;
+   m_lastArrival = arrived;
+   m_started = true;
+   return advance;
+}
+
+SimClock::Stats SimClock::GetStats () const {
+   std::lock_guard<std::mutex> lock(m_mutex);
+   return m_stats;
+}
+
+} // namespace Module
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+#include "Metrics/Histogram.h"
+
+namespace Module {
+
+/// Fixed-timestep simulation clock driven by Tick.
+///
+/// Sim Manager numbers every Tick and sends them at a fixed period. Counting Ticks as they
+/// arrive loses time whenever one is late, dropped on the network or dropped from a queue.
+/// The clock instead compares each frame number with the last one it saw: a repeated or older
+/// frame is a duplicate and does not advance, and a jump forward is a gap whose missed steps
+/// are either run to catch up or skipped, depending on the catch-up policy.
+///
+/// It also compares when each Tick arrived with when it was due, one period after the last,
+/// and keeps the interval and jitter in histograms.
+///
+/// OnTick is meant for a single thread, normally the module loop. GetStats may be called from
+/// any thread. Simulation time itself belongs to module state, which adds up Advance::seconds
+/// while the simulation is running.
+class SimClock {
+public:
+   using Clock = std::chrono::steady_clock;
+
+   enum class CatchUp {
+      /// Run one step for every missed frame, up to maxCatchUpSteps.
+      RunMissed,
+
+      /// Run a single step and let simulation time jump to the latest frame.
+      SkipToLatest
+   };
+
+   struct Options {
+      /// Expected time between Ticks.
+      Clock::duration period = std::chrono::milliseconds(20);
+
+      CatchUp catchUp = CatchUp::RunMissed;
+
+      /// Most steps run for one Tick under RunMissed. The rest are skipped.
+      std::uint32_t maxCatchUpSteps = 10;
+   };
+
+   /// What a module should do for one Tick.
+   struct Advance {
+      /// Update steps to run. Zero for a duplicate.
+      std::uint32_t steps;
+
+      /// Simulation seconds each step covers, the period scaled by time dilation.
+      double stepSeconds;
+
+      /// Frames between this Tick and the last one that never arrived.
+      std::int64_t missed;
+
+      /// Simulation seconds this Tick covers, missed frames included.
+      /// Simulation time follows the frame number even when steps are skipped.
+      double seconds;
+   };
+
+   struct Stats {
+      std::uint64_t ticks;
+      std::uint64_t duplicates;
+      std::uint64_t gaps;
+      std::uint64_t missedFrames;
+      std::uint64_t skippedSteps;
+      std::int64_t lastFrame;
+
+      /// Nanoseconds between consecutive Ticks, per frame.
+      Metrics::Histogram interval;
+
+      /// Nanoseconds each Tick arrived away from when it was due, early or late.
+      Metrics::Histogram jitter;
+   };
+
+   explicit SimClock (Options options);
+
+   /// Accounts for a Tick and returns the steps to run for it.
+   Advance OnTick (std::int64_t frame, float timeDilation, Clock::time_point arrived = Clock::now());
+
+   /// Copies the statistics, including both histograms.
+   Stats GetStats () const;
+
+private:
+   Options m_options;
+
+   mutable std::mutex m_mutex;
+   Stats m_stats;
+   bool m_started;
+   Clock::time_point m_lastArrival;
+};
+
+} // namespace Module
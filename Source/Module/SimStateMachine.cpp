@@ -0,0 +1,99 @@
+#include "Module/SimStateMachine.h"
+
+namespace Module {
+
+SimStateMachine::SimStateMachine ()
+   : m_word(Pack(false, SimEvent::Halt, 0)), m_effected(0) {
+   for (std::uint32_t i = 0; i < HistorySize; ++i) {
+      m_appliedAt[i] = 0;
+      m_appliedEvent[i] = 0;
+   }
+   for (int i = 0; i < static_cast<int>(SimEvent::Count); ++i) {
+      m_count[i] = 0;
+      m_total[i] = 0;
+      m_max[i] = 0;
+   }
+}
+
+SimStateMachine::Snapshot SimStateMachine::Apply (SimEvent event) {
+   if (event == SimEvent::Save) return Current();
+
+   bool running = event == SimEvent::Run;
+   auto now = Clock::now().time_since_epoch().count();
+
+   std::uint32_t word = m_word.load();
+   std::uint32_t next;
+   do {
+      Snapshot current = Unpack(word);
+      next = Pack(running, event, current.generation + 1);
+
+      /// Stamp the slot for the generation about to be published. If the swap fails,
+      /// the loop stamps whichever generation it retries with.
+      std::uint32_t slot = (current.generation + 1) % HistorySize;
+      m_appliedAt[slot] = now;
+      m_appliedEvent[slot] = static_cast<std::uint32_t>(event);
+   } while (!m_word.compare_exchange_weak(word, next));
+
+   return Unpack(next);
+}
+
+SimStateMachine::Snapshot SimStateMachine::Apply (AMM::ControlType type) {
+   switch (type) {
+   case AMM::ControlType::RUN :   return Apply(SimEvent::Run);
+   case AMM::ControlType::HALT :  return Apply(SimEvent::Halt);
+   case AMM::ControlType::RESET : return Apply(SimEvent::Reset);
+   case AMM::ControlType::SAVE :  return Apply(SimEvent::Save);
+   }
+   return Current();
+}
+
+bool SimStateMachine::IsRunning () const {
+   return (m_word.load() & 1u) != 0;
+}
+
+SimStateMachine::Snapshot SimStateMachine::Current () const {
+   return Unpack(m_word.load());
+}
+
+void SimStateMachine::MarkEffect (std::uint32_t generation) {
+   if (generation == 0) return;
+
+   /// Generations only move forward, so the latest effected generation is enough to tell
+   /// whether this one has already been counted.
+   std::uint32_t effected = m_effected.load();
+   do {
+      if (effected >= generation) return;
+   } while (!m_effected.compare_exchange_weak(effected, generation));
+
+   std::uint32_t slot = generation % HistorySize;
+   Clock::rep latency = Clock::now().time_since_epoch().count() - m_appliedAt[slot].load();
+   int event = static_cast<int>(m_appliedEvent[slot].load());
+
+   m_count[event]++;
+   m_total[event] += latency;
+   Clock::rep max = m_max[event].load();
+   while (latency > max && !m_max[event].compare_exchange_weak(max, latency)) {}
+}
+
+SimStateMachine::LatencyStats SimStateMachine::GetLatency (SimEvent event) const {
+   int i = static_cast<int>(event);
+   LatencyStats stats;
+   stats.count = m_count[i];
+   stats.total = Clock::duration(m_total[i].load());
+   stats.max = Clock::duration(m_max[i].load());
+   return stats;
+}
+
+std::uint32_t SimStateMachine::Pack (bool running, SimEvent event, std::uint32_t generation) {
+   return (generation << 4) | (static_cast<std::uint32_t>(event) << 1) | (running ? 1u : 0u);
+}
+
+SimStateMachine::Snapshot SimStateMachine::Unpack (std::uint32_t word) {
+   Snapshot snapshot;
+   snapshot.running = (word & 1u) != 0;
+   snapshot.lastEvent = static_cast<SimEvent>((word >> 1) & 0x7u);
+   snapshot.generation = word >> 4;
+   return snapshot;
+}
+
+} // namespace Module
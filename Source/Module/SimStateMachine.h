@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <amm_std.h>
+
+namespace Module {
+
+/// Simulation Control inputs a module reacts to.
+enum class SimEvent : std::uint32_t {
+   Run,
+   Halt,
+   Reset,
+   Save,
+
+   /// New Module Configuration for this module. Modules must halt when this arrives.
+   ConfigChange,
+
+   Count
+};
+
+/// Whether a module's update loop is allowed to advance the simulation.
+///
+/// The state is a single atomic word holding the run flag, the last event and a generation
+/// counter, so transitions can be applied from any thread (including DDS listener threads)
+/// and read from any other without locks. A HALT applied on the listener thread is seen by
+/// the next Tick the module handles, even if older Ticks are still queued.
+///
+/// Transition-to-effect latency is the time between Apply and the first MarkEffect for that
+/// transition, which module code calls where the new state first changes what it does.
+class SimStateMachine {
+public:
+   using Clock = std::chrono::steady_clock;
+
+   struct Snapshot {
+      bool running;
+      SimEvent lastEvent;
+      std::uint32_t generation;
+   };
+
+   struct LatencyStats {
+      std::uint64_t count;
+      Clock::duration total;
+      Clock::duration max;
+   };
+
+   SimStateMachine ();
+
+   /// Applies an event atomically and returns the resulting state.
+   /// SAVE does not change whether the module runs and does not start a new generation.
+   Snapshot Apply (SimEvent event);
+
+   /// Applies the event for a Simulation Control sample's type.
+   Snapshot Apply (AMM::ControlType type);
+
+   bool IsRunning () const;
+
+   Snapshot Current () const;
+
+   /// Records that the transition with this generation has taken effect.
+   /// Only the first call per generation is counted.
+   void MarkEffect (std::uint32_t generation);
+
+   LatencyStats GetLatency (SimEvent event) const;
+
+private:
+   static std::uint32_t Pack (bool running, SimEvent event, std::uint32_t generation);
+   static Snapshot Unpack (std::uint32_t word);
+
+   /// Apply times of recent generations, so MarkEffect can match an effect to its transition.
+   static const std::uint32_t HistorySize = 16;
+
+   std::atomic<std::uint32_t> m_word;
+   std::atomic<std::uint32_t> m_effected;
+   std::atomic<Clock::rep> m_appliedAt[HistorySize];
+   std::atomic<std::uint32_t> m_appliedEvent[HistorySize];
+
+   std::atomic<std::uint64_t> m_count[static_cast<int>(SimEvent::Count)];
+   std::atomic<Clock::rep> m_total[static_cast<int>(SimEvent::Count)];
+   std::atomic<Clock::rep> m_max[static_cast<int>(SimEvent::Count)];
+};
+
+} // namespace Module
@@ -0,0 +1,115 @@
+#include "Module/StateFile.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace Module {
+
+namespace {
+
+/// "AMMS" as a little endian integer.
+const std::uint32_t StateFileMagic = 0x534D4D41;
+
+} // namespace
+
+StateWriter::StateWriter (std::uint32_t formatVersion)
+   : m_buffer(),
+     m_cdr(m_buffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::Cdr::DDS_CDR) {
+   m_cdr.serialize_encapsulation();
+   m_cdr << StateFileMagic;
+   m_cdr << formatVersion;
+}
+
+std::size_t StateWriter::Size () const {
+   return m_cdr.getSerializedDataLength();
+}
+
+int StateWriter::Save (const std::string& path, std::string& errmsg) {
+   std::string temp = path + ".tmp";
+   {
+      std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+      if (!out) {
+         errmsg = "Could not open " + temp + " for writing.";
+         return 1;
+      }
+      out.write(m_buffer.getBuffer(), static_cast<std::streamsize>(Size()));
+      if (!out) {
+         errmsg = "Could not write " + temp + ".";
+         return 1;
+      }
+   }
+
+   /// POSIX rename replaces path atomically. Windows rename refuses to replace an existing
+   /// file, so use MoveFileEx there instead of removing path first and losing it on a crash.
+#ifdef _WIN32
+   if (!MoveFileExA(temp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+#else
+   if (std::rename(temp.c_str(), path.c_str()) != 0) {
+#endif
+      errmsg = "Could not move " + temp + " to " + path + ".";
+      return 1;
+   }
+   return 0;
+}
+
+int StateWriter::Save (const std::string& path) {
+   std::string errmsg;
+   return Save(path, errmsg);
+}
+
+StateReader::StateReader () {
+}
+
+int StateReader::Load (const std::string& path, std::uint32_t formatVersion, std::string& errmsg) {
+   m_cdr.reset();
+   m_buffer.reset();
+
+   std::ifstream in(path, std::ios::binary);
+   if (!in) {
+      errmsg = "Could not open " + path + ".";
+      return 1;
+   }
+   m_data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+   m_buffer.reset(new eprosima::fastcdr::FastBuffer(m_data.data(), m_data.size()));
+   m_cdr.reset(new eprosima::fastcdr::Cdr(
+      *m_buffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::Cdr::DDS_CDR
+   ));
+
+   std::uint32_t magic = 0;
+   std::uint32_t version = 0;
+   try {
+      m_cdr->read_encapsulation();
+      *m_cdr >> magic;
+      *m_cdr >> version;
+   } catch (std::exception& e) {
+      m_cdr.reset();
+      errmsg = path + " is not a state file: " + e.what();
+      return 1;
+   }
+
+   if (magic != StateFileMagic) {
+      m_cdr.reset();
+      errmsg = path + " is not a state file.";
+      return 1;
+   }
+   if (version != formatVersion) {
+      m_cdr.reset();
+      errmsg = path + " has state format " + std::to_string(version)
+             + ", expected " + std::to_string(formatVersion) + ".";
+      return 1;
+   }
+   return 0;
+}
+
+int StateReader::Load (const std::string& path, std::uint32_t formatVersion) {
+   std::string errmsg;
+   return Load(path, formatVersion, errmsg);
+}
+
+} // namespace Module
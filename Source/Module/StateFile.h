@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fastcdr/Cdr.h>
+#include <fastcdr/FastBuffer.h>
+
+namespace Module {
+
+/// Compact binary save state for a module.
+///
+/// A state file is a single CDR stream, written with the same fastcdr serialization DDS uses
+/// on the wire: a magic number, a format version chosen by the module, then whatever the
+/// module writes, in order. AMM types serialize themselves, so a module's whole state can be
+/// saved and restored without touching its XML configuration files.
+///
+/// Like DDS Manager, Save and Load return 0 on success and 1 on failure, and write a message
+/// into errmsg describing what went wrong.
+class StateWriter {
+public:
+   explicit StateWriter (std::uint32_t formatVersion);
+
+   StateWriter (const StateWriter&) = delete;
+   StateWriter& operator= (const StateWriter&) = delete;
+
+   /// Appends an AMM type or a primitive value.
+   template <typename T>
+   StateWriter& Write (const T& value) {
+      m_cdr << value;
+      return *this;
+   }
+
+   /// Serialized bytes written so far.
+   std::size_t Size () const;
+
+   /// Writes the stream to path. The file is replaced in one step, so a crash mid-save
+   /// leaves the previous save intact.
+   int Save (const std::string& path, std::string& errmsg);
+   int Save (const std::string& path);
+
+private:
+   eprosima::fastcdr::FastBuffer m_buffer;
+   eprosima::fastcdr::Cdr m_cdr;
+};
+
+class StateReader {
+public:
+   StateReader ();
+
+   StateReader (const StateReader&) = delete;
+   StateReader& operator= (const StateReader&) = delete;
+
+   /// Reads path and checks its header against the expected format version.
+   int Load (const std::string& path, std::uint32_t formatVersion, std::string& errmsg);
+   int Load (const std::string& path, std::uint32_t formatVersion);
+
+   /// Reads the next value, in the order it was written.
+   /// Returns 1 and fills errmsg if the file ends early or is corrupt.
+   template <typename T>
+   int Read (T& value, std::string& errmsg) {
+      if (!m_cdr) {
+         errmsg = "State file is not loaded.";
+         return 1;
+      }
+      try {
+         *m_cdr >> value;
+      } catch (std::exception& e) {
+         errmsg = std::string("State file is truncated or corrupt: ") + e.what();
+         return 1;
+      }
+      return 0;
+   }
+
+private:
+   std::vector<char> m_data;
+   std::unique_ptr<eprosima::fastcdr::FastBuffer> m_buffer;
+   std::unique_ptr<eprosima::fastcdr::Cdr> m_cdr;
+};
+
+} // namespace Module
@@ -0,0 +1,113 @@
+#include "Module/StatusTable.h"
+
+#include <utility>
+#include <vector>
+
+namespace Module {
+
+StatusTable::StatusTable (RunLoop& loop, WriteFn write, Options options)
+   : m_loop(loop), m_write(std::move(write)), m_options(options) {
+}
+
+StatusTable::~StatusTable () {
+   m_loop.Cancel(this);
+}
+
+void StatusTable::Set (const AMM::Status& status) {
+   std::lock_guard<std::mutex> lock(m_mutex);
+
+   auto found = m_entries.find(status.capability());
+   if (found != m_entries.end() &&
+       found->second.status.value() == status.value() &&
+       found->second.status.message() == status.message()) {
+      return;
+   }
+
+   Entry& entry = m_entries[status.capability()];
+   entry.status = status;
+   m_stats.changes++;
+   MarkDirty(entry);
+}
+
+void StatusTable::Republish (const std::string& capability) {
+   std::lock_guard<std::mutex> lock(m_mutex);
+
+   auto found = m_entries.find(capability);
+   if (found != m_entries.end()) MarkDirty(found->second);
+}
+
+void StatusTable::MarkDirty (Entry& entry) {
+   if (entry.dirty) {
+      m_stats.coalesced++;
+      return;
+   }
+   entry.dirty = true;
+
+   if (!m_flushScheduled) {
+      m_flushScheduled = true;
+      m_loop.PostAfter(m_options.window, [this]() { OnWindowEnd(); }, this);
+   }
+}
+
+int StatusTable::Flush () {
+   std::lock_guard<std::mutex> writing(m_writeMutex);
+
+   std::vector<AMM::Status> pending;
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      /// Nothing is dirty after this, so the next change opens a new window. This also
+      /// recovers a table whose window timer was discarded by RunLoop::Stop.
+      m_flushScheduled = false;
+      for (auto& entry : m_entries) {
+         if (!entry.second.dirty) continue;
+         entry.second.dirty = false;
+         pending.push_back(entry.second.status);
+      }
+   }
+
+   /// The timestamp MUST be updated whenever a Status is published.
+   using namespace std::chrono;
+   auto timestamp = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+
+   int failed = 0;
+   for (auto& status : pending) {
+      status.timestamp(timestamp);
+      int result = m_write(status);
+
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stats.writes++;
+      if (result == 0) continue;
+      m_stats.failures++;
+      failed = 1;
+
+      /// Retry it next window, unless a newer value has already made it dirty again.
+      Entry& entry = m_entries[status.capability()];
+      if (!entry.dirty) MarkDirty(entry);
+   }
+   return failed;
+}
+
+void StatusTable::OnWindowEnd () {
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_flushScheduled = false;
+   }
+   Flush();
+}
+
+bool StatusTable::Get (const std::string& capability, AMM::Status& status) const {
+   std::lock_guard<std::mutex> lock(m_mutex);
+
+   auto found = m_entries.find(capability);
+   if (found == m_entries.end()) return false;
+   status = found->second.status;
+   return true;
+}
+
+StatusTable::Stats StatusTable::GetStats () const {
+   std::lock_guard<std::mutex> lock(m_mutex);
+   return m_stats;
+}
+
+} // namespace Module
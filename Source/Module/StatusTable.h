@@ -0,0 +1,94 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <amm_std.h>
+
+#include "Module/RunLoop.h"
+
+namespace Module {
+
+/// Latest Status of each of a module's capabilities, published with coalescing.
+///
+/// A capability whose status flaps many times a second would otherwise publish every
+/// change. Set records the new Status and marks the capability dirty. The first change
+/// schedules a flush one window later on the RunLoop, and every capability still dirty then
+/// is written once with its latest value and a fresh timestamp. Intermediate values within a
+/// window are never published, but the final one always is: a capability whose write fails
+/// is marked dirty again and retried at the end of the next window.
+///
+/// Set, Republish and Flush may be called from any thread. The table must outlive the loop's
+/// Run call.
+class StatusTable {
+public:
+   using Clock = RunLoop::Clock;
+
+   /// Publishes one Status, e.g. mgr->WriteStatus(status). Returns the DDS Manager error code.
+   using WriteFn = std::function<int(AMM::Status&)>;
+
+   struct Options {
+      /// How long changes are collected before they are written.
+      Clock::duration window = std::chrono::milliseconds(100);
+   };
+
+   struct Stats {
+      std::uint64_t changes;
+      std::uint64_t coalesced;
+      std::uint64_t writes;
+      std::uint64_t failures;
+   };
+
+   StatusTable (RunLoop& loop, WriteFn write, Options options);
+
+   /// Cancels a pending window flush. Destroy on the loop thread or while it is not running.
+   ~StatusTable ();
+
+   StatusTable (const StatusTable&) = delete;
+   StatusTable& operator= (const StatusTable&) = delete;
+
+   /// Records status as the latest for its capability. Marks it dirty unless the value and
+   /// message are unchanged.
+   void Set (const AMM::Status& status);
+
+   /// Marks a capability dirty even though it has not changed, so it is written again.
+   void Republish (const std::string& capability);
+
+   /// Writes every dirty capability now instead of at the end of the window.
+   /// Returns 1 if any write failed. Those capabilities stay dirty for the next window.
+   int Flush ();
+
+   /// Latest Status recorded for a capability. Returns false if there is none.
+   bool Get (const std::string& capability, AMM::Status& status) const;
+
+   Stats GetStats () const;
+
+private:
+   struct Entry {
+      AMM::Status status;
+      bool dirty = false;
+   };
+
+   void MarkDirty (Entry& entry);
+   void OnWindowEnd ();
+
+   RunLoop& m_loop;
+   WriteFn m_write;
+   Options m_options;
+
+   mutable std::mutex m_mutex;
+   std::map<std::string, Entry> m_entries;
+   /// Set from the first change until the window's flush runs or Flush is called.
+   bool m_flushScheduled = false;
+
+   /// Held while writing, so two flushes cannot publish the same capability out of order.
+   std::mutex m_writeMutex;
+
+   Stats m_stats{ 0, 0, 0, 0 };
+};
+
+} // namespace Module
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+
+#include <amm_std.h>
+
+namespace Module {
+
+/// Drops samples a module has no use for at the start of its subscriber callback.
+///
+/// Every module receives every Module Configuration on the network, each with its full
+/// capabilities XML, and only the ones carrying its own Module ID matter. DDS Manager does not
+/// expose content filters or partitions, so samples still arrive and are deserialized. A
+/// filter rejects the rest before anything else is done with them: no copy into a handoff
+/// queue, no wake-up of the module loop, no handler call.
+///
+///    Module::TopicFilter<AMM::ModuleConfiguration> filter(
+///       Module::ForModule<AMM::ModuleConfiguration>(&moduleId), &QueueModuleConfiguration);
+///
+///    void OnNewModuleConfiguration (AMM::ModuleConfiguration& mc, eprosima::fastrtps::SampleInfo_t* info) {
+///       filter.OnSample(mc);
+///    }
+///
+/// Received and delivered counts show how much the filter saves.
+template <typename T>
+class TopicFilter {
+public:
+   using Predicate = std::function<bool(const T&)>;
+   using Sink = std::function<void(T&)>;
+
+   struct Stats {
+      std::uint64_t received;
+      std::uint64_t delivered;
+   };
+
+   TopicFilter (Predicate accept, Sink sink)
+      : m_accept(std::move(accept)), m_sink(std::move(sink)), m_received(0), m_delivered(0) {
+   }
+
+   TopicFilter (const TopicFilter&) = delete;
+   TopicFilter& operator= (const TopicFilter&) = delete;
+
+   /// Passes sample on to the sink if the predicate accepts it.
+   /// Returns whether it was passed on.
+   bool OnSample (T& sample) {
+      m_received.fetch_add(1, std::memory_order_relaxed);
+      if (!m_accept(sample)) return false;
+
+      m_delivered.fetch_add(1, std::memory_order_relaxed);
+      m_sink(sample);
+      return true;
+   }
+
+   Stats GetStats () const {
+      return Stats{ m_received.load(std::memory_order_relaxed), m_delivered.load(std::memory_order_relaxed) };
+   }
+
+private:
+   Predicate m_accept;
+   Sink m_sink;
+   std::atomic<std::uint64_t> m_received;
+   std::atomic<std::uint64_t> m_delivered;
+};
+
+/// Accepts samples whose module_id matches *moduleId.
+/// It is read on every sample, so it may be set after the filter is made, but must outlive
+/// the filter and must not change while samples are arriving. It is taken by pointer so that
+/// requirement shows where it is passed.
+template <typename T>
+typename TopicFilter<T>::Predicate ForModule (const AMM::UUID* moduleId) {
+   return [moduleId](const T& sample) {
+      return sample.module_id().id() == moduleId->id();
+   };
+}
+
+} // namespace Module
@@ -0,0 +1,46 @@
+#include "Module/Transport.h"
+
+#include <cstdlib>
+
+#include "Module/Logger.h"
+
+namespace Module {
+
+int ParseTransport (const std::string& name, Transport& transport) {
+   if      (name == "default") transport = Transport::Default;
+   else if (name == "udp")     transport = Transport::Udp;
+   else if (name == "shm")     transport = Transport::SharedMemory;
+   else if (name == "intra")   transport = Transport::IntraProcess;
+   else return 1;
+   return 0;
+}
+
+const char* TransportName (Transport transport) {
+   switch (transport) {
+      case Transport::Udp:          return "udp";
+      case Transport::SharedMemory: return "shm";
+      case Transport::IntraProcess: return "intra";
+      default:                      return "default";
+   }
+}
+
+std::string TransportConfig (Transport transport, const std::string& configDir) {
+   switch (transport) {
+      case Transport::Udp:          return configDir + "/Transport_UDP.xml";
+      case Transport::SharedMemory: return configDir + "/Transport_SHM.xml";
+      case Transport::IntraProcess: return configDir + "/Transport_IntraProcess.xml";
+      default:                      return configDir + "/Config.xml";
+   }
+}
+
+std::string TransportConfigFromEnvironment (const std::string& configDir) {
+   Transport transport = Transport::Default;
+   const char* name = std::getenv("AMM_TRANSPORT");
+   if (name != nullptr && ParseTransport(name, transport) != 0) {
+      Log().Warning(std::string("Unknown AMM_TRANSPORT \"") + name +
+                    "\", expected default, udp, shm or intra. Using Config.xml.");
+   }
+   return TransportConfig(transport, configDir);
+}
+
+} // namespace Module
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+
+namespace Module {
+
+/// Transport profiles shipped in Config/, selectable per deployment.
+///
+/// Each profile is a complete participant configuration with the same amm_participant
+/// profile as Config.xml, so a DDS Manager picks a transport just by being given its file.
+/// Default keeps Config.xml and the FastRTPS built-in transports.
+///
+///    Udp            Config/Transport_UDP.xml             UDP only, the baseline
+///    SharedMemory   Config/Transport_SHM.xml             shared memory on one host, UDP beyond it
+///    IntraProcess   Config/Transport_IntraProcess.xml    direct delivery within one process
+///
+/// Intra-process delivery is a process-wide setting, so every DDS Manager in a process must
+/// use the same profile.
+enum class Transport {
+   Default,
+   Udp,
+   SharedMemory,
+   IntraProcess
+};
+
+/// Parses "default", "udp", "shm" or "intra". Returns 1 and leaves transport unchanged for
+/// anything else.
+int ParseTransport (const std::string& name, Transport& transport);
+
+const char* TransportName (Transport transport);
+
+/// Path of the configuration file for transport, inside configDir.
+std::string TransportConfig (Transport transport, const std::string& configDir = "Config");
+
+/// Configuration file for the transport named by the AMM_TRANSPORT environment variable,
+/// or Config.xml if it is unset. An unknown name also falls back to Config.xml, with a
+/// warning on Module::Log.
+std::string TransportConfigFromEnvironment (const std::string& configDir = "Config");
+
+} // namespace Module
@@ -0,0 +1,169 @@
+#include "Module/Uuid.h"
+
+#include <random>
+
+namespace Module {
+
+namespace {
+
+/// Value of each hex digit character, and 0xFF for every other character.
+struct HexTable {
+   unsigned char value[256];
+
+   HexTable () {
+      for (int c = 0; c < 256; ++c) value[c] = 0xFF;
+      for (int c = 0; c < 10; ++c) value['0' + c] = static_cast<unsigned char>(c);
+      for (int c = 0; c < 6; ++c) {
+         value['a' + c] = static_cast<unsigned char>(10 + c);
+         value['A' + c] = static_cast<unsigned char>(10 + c);
+      }
+   }
+};
+
+const HexTable hex;
+
+/// Parses count hex digits from text into word. Returns false on anything else.
+bool ParseHex (const char* text, int count, std::uint64_t& word) {
+   unsigned char bad = 0;
+   for (int i = 0; i < count; ++i) {
+      unsigned char value = hex.value[static_cast<unsigned char>(text[i])];
+      bad |= value;
+      word = (word << 4) | (value & 0xF);
+   }
+   return (bad & 0xF0) == 0;
+}
+
+/// Writes the low count hex digits of word into out, most significant first.
+void FormatHex (std::uint64_t word, int count, char* out) {
+   static const char digits[] = "0123456789abcdef";
+   for (int i = count - 1; i >= 0; --i) {
+      out[i] = digits[word & 0xF];
+      word >>= 4;
+   }
+}
+
+std::size_t IndexSize (std::size_t capacity) {
+   std::size_t size = 2;
+   while (size < capacity * 2) size <<= 1;
+   return size;
+}
+
+} // namespace
+
+int Uuid::Parse (const std::string& text, Uuid& out) {
+   if (text.size() != 36) return 1;
+
+   const char* p = text.data();
+   if (p[8] != '-' || p[13] != '-' || p[18] != '-' || p[23] != '-') return 1;
+
+   std::uint64_t high = 0;
+   std::uint64_t low = 0;
+   bool valid = ParseHex(p, 8, high)
+             && ParseHex(p + 9, 4, high)
+             && ParseHex(p + 14, 4, high)
+             && ParseHex(p + 19, 4, low)
+             && ParseHex(p + 24, 12, low);
+   if (!valid) return 1;
+
+   out.high = high;
+   out.low = low;
+   return 0;
+}
+
+Uuid Uuid::Generate () {
+   thread_local std::mt19937_64 engine(std::random_device{}());
+
+   Uuid uuid;
+   uuid.high = engine();
+   uuid.low = engine();
+
+   /// Version 4, variant 1 (RFC 4122).
+   uuid.high = (uuid.high & ~0xF000ull) | 0x4000ull;
+   uuid.low = (uuid.low & ~(0xC000000000000000ull)) | 0x8000000000000000ull;
+   return uuid;
+}
+
+void Uuid::Format (char (&out)[37]) const {
+   FormatHex(high >> 32, 8, out);
+   out[8] = '-';
+   FormatHex(high >> 16, 4, out + 9);
+   out[13] = '-';
+   FormatHex(high, 4, out + 14);
+   out[18] = '-';
+   FormatHex(low >> 48, 4, out + 19);
+   out[23] = '-';
+   FormatHex(low, 12, out + 24);
+   out[36] = '\0';
+}
+
+std::string Uuid::ToString () const {
+   char text[37];
+   Format(text);
+   return std::string(text, 36);
+}
+
+AMM::UUID Uuid::ToAmm () const {
+   AMM::UUID uuid;
+   uuid.id(ToString());
+   return uuid;
+}
+
+const UuidTable::Id UuidTable::None;
+
+UuidTable::UuidTable (std::size_t capacity)
+   : m_capacity(capacity), m_uuids(new Uuid[capacity]), m_size(0),
+     m_indexMask(IndexSize(capacity) - 1), m_index(new std::atomic<Id>[m_indexMask + 1]) {
+   for (std::size_t i = 0; i <= m_indexMask; ++i) m_index[i].store(None, std::memory_order_relaxed);
+}
+
+/// Probes the index for uuid. Returns the position where it was found, with its Id,
+/// or the empty position where it would go, with None.
+std::size_t UuidTable::IndexOf (const Uuid& uuid, Id& id) const {
+   std::size_t pos = uuid.Hash() & m_indexMask;
+   for (;;) {
+      id = m_index[pos].load(std::memory_order_acquire);
+      if (id == None || m_uuids[id] == uuid) return pos;
+      pos = (pos + 1) & m_indexMask;
+   }
+}
+
+UuidTable::Id UuidTable::Intern (const Uuid& uuid) {
+   Id id;
+   IndexOf(uuid, id);
+   if (id != None) return id;
+
+   std::lock_guard<std::mutex> lock(m_mutex);
+
+   /// Another thread may have added it since.
+   std::size_t pos = IndexOf(uuid, id);
+   if (id != None) return id;
+
+   std::size_t size = m_size.load(std::memory_order_relaxed);
+   if (size >= m_capacity) return None;
+
+   id = static_cast<Id>(size);
+   m_uuids[id] = uuid;
+   m_index[pos].store(id, std::memory_order_release);
+   m_size.store(size + 1, std::memory_order_release);
+   return id;
+}
+
+UuidTable::Id UuidTable::Intern (const AMM::UUID& uuid) {
+   Uuid parsed;
+   if (Uuid::Parse(uuid.id(), parsed) != 0) return None;
+   return Intern(parsed);
+}
+
+UuidTable::Id UuidTable::Find (const Uuid& uuid) const {
+   Id id;
+   IndexOf(uuid, id);
+   return id;
+}
+
+UuidTable::Id UuidTable::Find (const AMM::UUID& uuid) const {
+   Uuid parsed;
+   if (Uuid::Parse(uuid.id(), parsed) != 0) return None;
+   return Find(parsed);
+}
+
+} // namespace Module
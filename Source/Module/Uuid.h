@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <amm_std.h>
+
+namespace Module {
+
+/// A 128 bit UUID held as two integers.
+///
+/// AMM::UUID carries IDs as 36 character text, so every comparison is a string comparison
+/// and every hash reads the whole string. Parsed once into a Uuid, an ID compares and
+/// hashes in a couple of instructions and is copied without allocating.
+struct Uuid {
+   std::uint64_t high = 0;
+   std::uint64_t low = 0;
+
+   /// Parses the canonical 8-4-4-4-12 hex form, in either case, as produced by
+   /// DDSManager::GenerateUuidString. Returns 1 and leaves out unchanged for anything else.
+   static int Parse (const std::string& text, Uuid& out);
+
+   /// A random (version 4) UUID.
+   static Uuid Generate ();
+
+   /// Writes the canonical lower case form and a terminating null into out.
+   void Format (char (&out)[37]) const;
+
+   std::string ToString () const;
+
+   AMM::UUID ToAmm () const;
+
+   bool IsNil () const { return high == 0 && low == 0; }
+
+   std::size_t Hash () const {
+      std::uint64_t h = high ^ (low * 0x9E3779B97F4A7C15ull);
+      return static_cast<std::size_t>(h ^ (h >> 32));
+   }
+};
+
+inline bool operator== (const Uuid& a, const Uuid& b) { return a.high == b.high && a.low == b.low; }
+inline bool operator!= (const Uuid& a, const Uuid& b) { return !(a == b); }
+inline bool operator< (const Uuid& a, const Uuid& b) { return a.high != b.high ? a.high < b.high : a.low < b.low; }
+
+struct UuidHash {
+   std::size_t operator() (const Uuid& uuid) const { return uuid.Hash(); }
+};
+
+/// Interns UUIDs as small dense IDs.
+///
+/// A module sees the same few IDs on every sample: its own Module ID, the educational
+/// encounter, the events it assesses. Interning gives each an Id from 0 up, so runtime tables
+/// can be arrays indexed by Id and comparisons are integer comparisons. Lookups never lock or
+/// allocate; only adding a new UUID takes a mutex. Safe to use from any thread.
+class UuidTable {
+public:
+   using Id = std::uint32_t;
+
+   /// Returned when a UUID is not present, does not parse, or the table is full.
+   static const Id None = 0xFFFFFFFFu;
+
+   explicit UuidTable (std::size_t capacity = 1024);
+
+   UuidTable (const UuidTable&) = delete;
+   UuidTable& operator= (const UuidTable&) = delete;
+
+   /// Returns uuid's Id, adding it if needed.
+   Id Intern (const Uuid& uuid);
+   Id Intern (const AMM::UUID& uuid);
+
+   /// Returns uuid's Id, or None if it has not been interned.
+   Id Find (const Uuid& uuid) const;
+   Id Find (const AMM::UUID& uuid) const;
+
+   /// The UUID interned as id. id must be below Size.
+   const Uuid& UuidOf (Id id) const { return m_uuids[id]; }
+
+   std::size_t Size () const { return m_size.load(std::memory_order_acquire); }
+
+   std::size_t Capacity () const { return m_capacity; }
+
+private:
+   std::size_t IndexOf (const Uuid& uuid, Id& id) const;
+
+   const std::size_t m_capacity;
+   std::unique_ptr<Uuid[]> m_uuids;
+   std::atomic<std::size_t> m_size;
+
+   /// Open addressing index from hash to Id. Written only under m_mutex.
+   const std::size_t m_indexMask;
+   std::unique_ptr<std::atomic<Id>[]> m_index;
+   std::mutex m_mutex;
+};
+
+} // namespace Module
@@ -0,0 +1,149 @@
+#include "Module/ValueCache.h"
+
+#include <functional>
+#include <thread>
+
+namespace Module {
+
+const ValueCache::Id ValueCache::None;
+
+namespace {
+
+std::size_t IndexSize (std::size_t capacity) {
+   std::size_t size = 2;
+   while (size < capacity * 2) size <<= 1;
+   return size;
+}
+
+}
+
+ValueCache::ValueCache (std::size_t capacity)
+   : m_capacity(capacity), m_slots(new Slot[capacity]), m_size(0), m_version(0),
+     m_names(new std::string[capacity]),
+     m_indexMask(IndexSize(capacity) - 1), m_index(new std::atomic<Id>[m_indexMask + 1]) {
+   for (std::size_t i = 0; i < m_capacity; ++i) {
+      m_slots[i].seq.store(0, std::memory_order_relaxed);
+      m_slots[i].value.store(0.0, std::memory_order_relaxed);
+      m_slots[i].timestamp.store(0, std::memory_order_relaxed);
+      m_slots[i].updates.store(0, std::memory_order_relaxed);
+   }
+   for (std::size_t i = 0; i <= m_indexMask; ++i) m_index[i].store(None, std::memory_order_relaxed);
+}
+
+/// Probes the index for name. Returns the position where it was found, with its ID,
+/// or the empty position where it would go, with None.
+std::size_t ValueCache::IndexOf (const std::string& name, Id& id) const {
+   std::size_t pos = std::hash<std::string>()(name) & m_indexMask;
+   for (;;) {
+      id = m_index[pos].load(std::memory_order_acquire);
+      if (id == None || m_names[id] == name) return pos;
+      pos = (pos + 1) & m_indexMask;
+   }
+}
+
+ValueCache::Id ValueCache::Intern (const std::string& name) {
+   Id id;
+   IndexOf(name, id);
+   if (id != None) return id;
+
+   std::lock_guard<std::mutex> lock(m_namesMutex);
+
+   /// Another thread may have added it since.
+   std::size_t pos = IndexOf(name, id);
+   if (id != None) return id;
+
+   std::size_t size = m_size.load(std::memory_order_relaxed);
+   if (size >= m_capacity) return None;
+
+   id = static_cast<Id>(size);
+   m_names[id] = name;
+   m_index[pos].store(id, std::memory_order_release);
+   m_size.store(size + 1, std::memory_order_release);
+   return id;
+}
+
+ValueCache::Id ValueCache::Find (const std::string& name) const {
+   Id id;
+   IndexOf(name, id);
+   return id;
+}
+
+std::string ValueCache::NameOf (Id id) const {
+   return id < Size() ? m_names[id] : std::string();
+}
+
+void ValueCache::Update (const AMM::PhysiologyValue& sample) {
+   Id id = Intern(sample.name());
+   if (id != None) Update(id, sample.value(), sample.timestamp());
+}
+
+void ValueCache::Update (Id id, double value, long long timestamp) {
+   if (id >= m_capacity) return;
+   Slot& slot = m_slots[id];
+
+   /// Claim the slot by making its sequence odd. Writers to the same name from different
+   /// listener threads take turns here. Readers are never held up.
+   std::uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+   for (;;) {
+      if ((seq & 1) == 0 &&
+          slot.seq.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+         break;
+      }
+      std::this_thread::yield();
+      seq = slot.seq.load(std::memory_order_relaxed);
+   }
+   std::atomic_thread_fence(std::memory_order_release);
+
+   slot.value.store(value, std::memory_order_relaxed);
+   slot.timestamp.store(timestamp, std::memory_order_relaxed);
+   slot.updates.store(slot.updates.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+   slot.seq.store(seq + 2, std::memory_order_release);
+   m_version.fetch_add(1, std::memory_order_release);
+}
+
+bool ValueCache::Get (Id id, Value& out) const {
+   if (id >= m_capacity) return false;
+   const Slot& slot = m_slots[id];
+
+   for (;;) {
+      std::uint32_t before = slot.seq.load(std::memory_order_acquire);
+      out.value = slot.value.load(std::memory_order_relaxed);
+      out.timestamp = slot.timestamp.load(std::memory_order_relaxed);
+      out.updates = slot.updates.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+
+      if ((before & 1) == 0 && slot.seq.load(std::memory_order_relaxed) == before) break;
+   }
+   return out.updates != 0;
+}
+
+std::size_t ValueCache::Get (const Id* ids, std::size_t count, Value* out) const {
+   std::size_t found = 0;
+   for (std::size_t i = 0; i < count; ++i) {
+      if (Get(ids[i], out[i])) found++;
+   }
+   return found;
+}
+
+bool ValueCache::Snapshot (const Id* ids, std::size_t count, Value* out) const {
+   /// Each value read carries its slot's update count, and a slot's sequence is twice that
+   /// while no write is in progress. If no slot has moved on from the value read by the time
+   /// all of them are checked, every value held at once, just before the checks began.
+   const int attempts = 16;
+   for (int attempt = 0; attempt < attempts; ++attempt) {
+      Get(ids, count, out);
+      std::atomic_thread_fence(std::memory_order_acquire);
+
+      bool unchanged = true;
+      for (std::size_t i = 0; i < count && unchanged; ++i) {
+         if (ids[i] >= m_capacity) continue;
+         auto seq = m_slots[ids[i]].seq.load(std::memory_order_acquire);
+         unchanged = seq == static_cast<std::uint32_t>(out[i].updates * 2);
+      }
+      if (unchanged) return true;
+   }
+   return false;
+}
+
+} // namespace Module
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <amm_std.h>
+
+namespace Module {
+
+/// Latest value of every Physiology Value name a module has seen.
+///
+/// DDS Manager only delivers Physiology Values as per-sample callbacks. The cache keeps the
+/// newest sample for each name so module logic, usually on the Tick thread, can just look up
+/// the current heart rate. Update it straight from the subscriber callback, no handoff needed:
+///
+///    void OnPhysiologyValue (AMM::PhysiologyValue& value, eprosima::fastrtps::SampleInfo_t* info) {
+///       physiology.Update(value);
+///    }
+///
+/// Names are interned into dense integer IDs, and values live in one flat array indexed by
+/// ID. Resolve names with Intern or Find once, up front. Lookups by ID take no lock: each
+/// slot is a sequence lock, and a read only repeats if a write to that same slot lands in the
+/// middle of it. Each value read is consistent with its own timestamp. Snapshot reads several
+/// values as they all stood at one moment, for logic that compares them with each other.
+/// Neither ever holds up a writer, so listener threads never wait on module logic.
+///
+/// The capacity is fixed, so the array never moves under a reader.
+class ValueCache {
+public:
+   using Id = std::uint32_t;
+
+   /// Returned for a name that is not in the cache, or when the cache is full.
+   static const Id None = ~Id(0);
+
+   struct Value {
+      double value;
+      long long timestamp;
+
+      /// Times this name has been updated. Zero means no value yet.
+      std::uint64_t updates;
+   };
+
+   explicit ValueCache (std::size_t capacity = 1024);
+
+   ValueCache (const ValueCache&) = delete;
+   ValueCache& operator= (const ValueCache&) = delete;
+
+   /// ID for name, adding it if new. Only adding a name takes a lock.
+   Id Intern (const std::string& name);
+
+   /// ID for name, or None if it has never been interned. Hashes and compares the name,
+   /// so resolve IDs once rather than on every read.
+   Id Find (const std::string& name) const;
+
+   std::string NameOf (Id id) const;
+
+   /// Stores a received sample as the latest value for its name.
+   void Update (const AMM::PhysiologyValue& sample);
+   void Update (Id id, double value, long long timestamp);
+
+   /// Latest value for id. Returns false if there is none yet.
+   bool Get (Id id, Value& out) const;
+
+   /// Reads count values at once. Each is consistent with its own timestamp, but updates
+   /// can land between two of them, so this is not a snapshot. Returns how many had a value.
+   std::size_t Get (const Id* ids, std::size_t count, Value* out) const;
+
+   /// Like the batch Get, but tries to read every value as it stood at one moment: it reads
+   /// them all, then checks that none of those names was updated since. Retries a bounded
+   /// number of times while updates to them keep landing, and never holds writers back.
+   /// Returns false if every attempt was overtaken. out then holds a partial snapshot, with
+   /// each value consistent with its own timestamp as in the batch Get.
+   bool Snapshot (const Id* ids, std::size_t count, Value* out) const;
+
+   /// Increases with every update to any name, so a reader can tell whether to look again.
+   std::uint64_t Version () const { return m_version.load(std::memory_order_acquire); }
+
+   std::size_t Size () const { return m_size.load(std::memory_order_acquire); }
+   std::size_t Capacity () const { return m_capacity; }
+
+private:
+   struct Slot {
+      /// Odd while a write is in progress. Otherwise twice the updates, wrapping, so
+      /// Snapshot can tell from a value it read whether the slot has changed since.
+      std::atomic<std::uint32_t> seq;
+      std::atomic<double> value;
+      std::atomic<long long> timestamp;
+      std::atomic<std::uint64_t> updates;
+   };
+
+   const std::size_t m_capacity;
+   std::unique_ptr<Slot[]> m_slots;
+   std::atomic<std::size_t> m_size;
+   std::atomic<std::uint64_t> m_version;
+
+   /// Names by ID. An entry is written once, before its ID is published in the index.
+   std::unique_ptr<std::string[]> m_names;
+
+   /// Open addressing hash index from name to ID, at most half full. Lookups read it
+   /// without a lock. Entries are only ever added, under m_namesMutex.
+   std::size_t m_indexMask;
+   std::unique_ptr<std::atomic<Id>[]> m_index;
+   std::mutex m_namesMutex;
+
+   std::size_t IndexOf (const std::string& name, Id& id) const;
+};
+
+} // namespace Module
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace Module {
+
+/// An immutable, shared, versioned value.
+///
+/// Copying a Versioned copies a pointer, never the value, so module state that carries large
+/// blobs (Module Configuration XML, per-capability Status) can be snapshotted and restored
+/// without allocating. Changes go through With, which copies the value once, applies the
+/// change and returns a new version. Anyone still holding an older version keeps it alive and
+/// unchanged until they let go of it.
+template <typename T>
+class Versioned {
+public:
+   /// A default constructed T, shared by every default constructed Versioned.
+   Versioned ()
+      : m_value(Empty()), m_version(0) {
+   }
+
+   explicit Versioned (T value)
+      : m_value(std::make_shared<const T>(std::move(value))), m_version(NextVersion()) {
+   }
+
+   const T& operator* () const { return *m_value; }
+   const T* operator-> () const { return m_value.get(); }
+
+   /// Process-wide unique for every value created through the constructor or With.
+   /// Zero for a default constructed value.
+   std::uint64_t Version () const {
+      return m_version;
+   }
+
+   /// Returns a new version with fn applied to a copy of this value.
+   template <typename Fn>
+   Versioned With (Fn fn) const {
+      T copy = *m_value;
+      fn(copy);
+      return Versioned(std::move(copy));
+   }
+
+   /// Whether both refer to the very same version.
+   bool SameAs (const Versioned& other) const {
+      return m_value == other.m_value;
+   }
+
+private:
+   static const std::shared_ptr<const T>& Empty () {
+      static const std::shared_ptr<const T> empty = std::make_shared<const T>();
+      return empty;
+   }
+
+   static std::uint64_t NextVersion () {
+      static std::atomic<std::uint64_t> counter(0);
+      return ++counter;
+   }
+
+   std::shared_ptr<const T> m_value;
+   std::uint64_t m_version;
+};
+
+} // namespace Module
@@ -0,0 +1,262 @@
+#include "Module/Waveform.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <utility>
+
+namespace Module {
+
+namespace {
+
+const std::string instrumentPrefix = "Waveform/";
+
+/// Marks the payload format, so a change to it is not misread by older subscribers.
+/// AMMW2 added the publisher session.
+const std::string payloadTag = "AMMW2";
+
+const char base64Digits[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/// Appends the values as little endian IEEE doubles in base 64.
+/// Instrument Data payloads are strings, and base 64 keeps the values exact.
+void AppendValues (const std::vector<double>& values, std::string& out) {
+   std::string bytes;
+   bytes.reserve(values.size() * 8);
+   for (double value : values) {
+      std::uint64_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      for (int i = 0; i < 8; ++i) bytes.push_back(static_cast<char>((bits >> (8 * i)) & 0xFF));
+   }
+
+   out.reserve(out.size() + (bytes.size() + 2) / 3 * 4);
+   for (std::size_t i = 0; i < bytes.size(); i += 3) {
+      std::uint32_t n = static_cast<unsigned char>(bytes[i]) << 16;
+      if (i + 1 < bytes.size()) n |= static_cast<unsigned char>(bytes[i + 1]) << 8;
+      if (i + 2 < bytes.size()) n |= static_cast<unsigned char>(bytes[i + 2]);
+
+      out.push_back(base64Digits[(n >> 18) & 63]);
+      out.push_back(base64Digits[(n >> 12) & 63]);
+      out.push_back(i + 1 < bytes.size() ? base64Digits[(n >> 6) & 63] : '=');
+      out.push_back(i + 2 < bytes.size() ? base64Digits[n & 63] : '=');
+   }
+}
+
+int DigitValue (char c) {
+   if (c >= 'A' && c <= 'Z') return c - 'A';
+   if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+   if (c >= '0' && c <= '9') return c - '0' + 52;
+   if (c == '+') return 62;
+   if (c == '/') return 63;
+   return -1;
+}
+
+int ReadValues (const std::string& text, std::size_t pos, std::size_t count, std::vector<double>& values) {
+   /// count comes off the network. Check it against what the payload can hold before
+   /// sizing anything by it, so a malformed chunk cannot overflow or exhaust memory.
+   if (pos > text.size()) return 1;
+   std::size_t capacity = (text.size() - pos) / 4 * 3;
+   if (count > capacity / 8) return 1;
+
+   std::string bytes;
+   bytes.reserve(count * 8);
+
+   std::uint32_t n = 0;
+   int bits = 0;
+   for (; pos < text.size() && text[pos] != '='; ++pos) {
+      int digit = DigitValue(text[pos]);
+      if (digit < 0) return 1;
+      n = (n << 6) | static_cast<std::uint32_t>(digit);
+      bits += 6;
+      if (bits >= 8) {
+         bits -= 8;
+         bytes.push_back(static_cast<char>((n >> bits) & 0xFF));
+      }
+   }
+   if (bytes.size() != count * 8) return 1;
+
+   values.resize(count);
+   for (std::size_t v = 0; v < count; ++v) {
+      std::uint64_t word = 0;
+      for (int i = 0; i < 8; ++i) {
+         word |= static_cast<std::uint64_t>(static_cast<unsigned char>(bytes[v * 8 + i])) << (8 * i);
+      }
+      std::memcpy(&values[v], &word, sizeof(word));
+   }
+   return 0;
+}
+
+/// A session ID unlikely to repeat across publishers and restarts. Never 0.
+std::uint64_t NewSession () {
+   std::random_device device;
+   std::uint64_t session = (static_cast<std::uint64_t>(device()) << 32) ^ device();
+   session ^= static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+   return session == 0 ? 1 : session;
+}
+
+} // namespace
+
+std::string WaveformInstrument (const std::string& name) {
+   return instrumentPrefix + name;
+}
+
+void EncodeWaveformChunk (const WaveformChunk& chunk, AMM::InstrumentData& data) {
+   std::string payload = payloadTag;
+   payload += ' ';
+   payload += std::to_string(chunk.session);
+   payload += ' ';
+   payload += std::to_string(chunk.seq);
+   payload += ' ';
+   payload += std::to_string(chunk.firstIndex);
+   payload += ' ';
+   payload += std::to_string(chunk.firstTimestamp);
+   payload += ' ';
+   payload += std::to_string(chunk.lastTimestamp);
+   payload += ' ';
+   payload += std::to_string(chunk.values.size());
+   payload += ' ';
+   AppendValues(chunk.values, payload);
+
+   data.instrument(WaveformInstrument(chunk.name));
+   data.payload(std::move(payload));
+}
+
+int DecodeWaveformChunk (const AMM::InstrumentData& data, WaveformChunk& chunk) {
+   const std::string& instrument = data.instrument();
+   if (instrument.compare(0, instrumentPrefix.size(), instrumentPrefix) != 0) return 1;
+
+   const std::string& payload = data.payload();
+   if (payload.compare(0, payloadTag.size() + 1, payloadTag + " ") != 0) return 1;
+
+   const char* p = payload.c_str() + payloadTag.size();
+   char* end = nullptr;
+   chunk.session = std::strtoull(p, &end, 10);
+   chunk.seq = std::strtoull(end, &end, 10);
+   chunk.firstIndex = std::strtoull(end, &end, 10);
+   chunk.firstTimestamp = std::strtoll(end, &end, 10);
+   chunk.lastTimestamp = std::strtoll(end, &end, 10);
+   std::size_t count = static_cast<std::size_t>(std::strtoull(end, &end, 10));
+   if (*end != ' ') return 1;
+
+   chunk.name = instrument.substr(instrumentPrefix.size());
+   return ReadValues(payload, static_cast<std::size_t>(end - payload.c_str()) + 1, count, chunk.values);
+}
+
+
+WaveformPublisher::WaveformPublisher (RunLoop& loop, std::string name, WriteFn write, Options options)
+   : m_loop(loop), m_write(std::move(write)), m_options(options), m_ring(options.capacity),
+     m_nextIndex(0), m_dropped(0), m_chunks(0), m_failures(0) {
+   m_chunk.name = std::move(name);
+   m_chunk.session = NewSession();
+   m_chunk.values.reserve(m_options.chunkSize);
+
+   m_loop.AddWakeHandler([this]() { Publish(false); }, RunLoop::Priority::Bulk, this);
+   m_loop.PostEvery(m_options.maxLatency, [this]() { Publish(true); }, this);
+}
+
+WaveformPublisher::~WaveformPublisher () {
+   m_loop.Cancel(this);
+}
+
+void WaveformPublisher::Push (double value, long long timestamp) {
+   Point point{ value, timestamp, m_nextIndex.fetch_add(1, std::memory_order_relaxed) };
+   bool wake = false;
+
+   while (!m_ring.TryPush(point, wake)) {
+      Point oldest;
+      if (m_ring.TryPop(oldest)) m_dropped.fetch_add(1, std::memory_order_relaxed);
+   }
+
+   /// The loop only needs waking when a whole chunk is ready. Partial chunks, and any wake-up
+   /// missed while the loop drains at the same time, are picked up by the timer.
+   if (m_ring.Size() == m_options.chunkSize) m_loop.Notify();
+}
+
+void WaveformPublisher::Flush () {
+   Publish(true);
+}
+
+void WaveformPublisher::Publish (bool partial) {
+   for (;;) {
+      std::size_t available = m_ring.Size();
+      if (available == 0 || (!partial && available < m_options.chunkSize)) return;
+
+      m_chunk.values.clear();
+      Point point;
+      while (m_chunk.values.size() < m_options.chunkSize && m_ring.TryPop(point)) {
+         if (m_chunk.values.empty()) {
+            m_chunk.firstIndex = point.index;
+            m_chunk.firstTimestamp = point.timestamp;
+         } else if (point.index != m_chunk.firstIndex + m_chunk.values.size()) {
+            /// Points were dropped in between. Start a new chunk at this point,
+            /// so every chunk stays a run of consecutive points.
+            WriteChunk();
+            m_chunk.values.clear();
+            m_chunk.firstIndex = point.index;
+            m_chunk.firstTimestamp = point.timestamp;
+         }
+         m_chunk.values.push_back(point.value);
+         m_chunk.lastTimestamp = point.timestamp;
+      }
+      if (m_chunk.values.empty()) return;
+      WriteChunk();
+   }
+}
+
+void WaveformPublisher::WriteChunk () {
+   EncodeWaveformChunk(m_chunk, m_data);
+   m_chunk.seq++;
+   if (m_write(m_data) != 0) m_failures.fetch_add(1, std::memory_order_relaxed);
+   m_chunks.fetch_add(1, std::memory_order_relaxed);
+}
+
+WaveformPublisher::Stats WaveformPublisher::GetStats () const {
+   Stats stats;
+   stats.points = m_nextIndex.load(std::memory_order_relaxed);
+   stats.dropped = m_dropped.load(std::memory_order_relaxed);
+   stats.chunks = m_chunks.load(std::memory_order_relaxed);
+   stats.failures = m_failures.load(std::memory_order_relaxed);
+   return stats;
+}
+
+
+WaveformAssembler::WaveformAssembler (Handler handler)
+   : m_handler(std::move(handler)) {
+}
+
+void WaveformAssembler::OnInstrumentData (const AMM::InstrumentData& data) {
+   std::lock_guard<std::mutex> lock(m_mutex);
+   if (DecodeWaveformChunk(data, m_chunk) != 0) return;
+
+   auto found = m_streams.find(StreamKey(m_chunk.name, m_chunk.session));
+   if (found == m_streams.end()) {
+      /// First chunk of this session. Whatever it published before is not a loss.
+      found = m_streams.emplace(StreamKey(m_chunk.name, m_chunk.session), Stream()).first;
+      m_stats.streams++;
+   } else {
+      Stream& stream = found->second;
+      if (m_chunk.seq < stream.nextSeq) {
+         m_stats.duplicates++;
+         return;
+      }
+
+      m_stats.lostChunks += m_chunk.seq - stream.nextSeq;
+      if (m_chunk.firstIndex > stream.nextIndex) m_stats.lostPoints += m_chunk.firstIndex - stream.nextIndex;
+   }
+
+   Stream& stream = found->second;
+   stream.nextSeq = m_chunk.seq + 1;
+   stream.nextIndex = m_chunk.firstIndex + m_chunk.values.size();
+   m_stats.chunks++;
+   m_stats.points += m_chunk.values.size();
+
+   if (m_handler) m_handler(m_chunk);
+}
+
+WaveformAssembler::Stats WaveformAssembler::GetStats () const {
+   std::lock_guard<std::mutex> lock(m_mutex);
+   return m_stats;
+}
+
+} // namespace Module
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <amm_std.h>
+
+#include "Module/HandoffQueue.h"
+#include "Module/RunLoop.h"
+
+namespace Module {
+
+/// A run of consecutive points from one waveform.
+struct WaveformChunk {
+   /// Waveform name, e.g. "ECG_LeadII".
+   std::string name;
+
+   /// Picked at random by each WaveformPublisher, so chunks from a restarted publisher, or
+   /// from two publishers of the same name, are told apart from repeats.
+   std::uint64_t session = 0;
+
+   /// Chunk number, counting from 0 for each publisher. A gap means chunks were lost.
+   std::uint64_t seq = 0;
+
+   /// Index of the first point in the waveform, counting from 0.
+   /// A gap here without a gap in seq means the publisher dropped points.
+   std::uint64_t firstIndex = 0;
+
+   /// AMM timestamps (milliseconds) of the first and last point.
+   long long firstTimestamp = 0;
+   long long lastTimestamp = 0;
+
+   std::vector<double> values;
+};
+
+/// Instrument Data name that chunks of waveform name are published under.
+std::string WaveformInstrument (const std::string& name);
+
+/// Packs a chunk into an Instrument Data sample. The values are carried bit exact.
+void EncodeWaveformChunk (const WaveformChunk& chunk, AMM::InstrumentData& data);
+
+/// Unpacks a chunk. Returns 1 if data does not hold a waveform chunk.
+int DecodeWaveformChunk (const AMM::InstrumentData& data, WaveformChunk& chunk);
+
+/// Publishes a waveform in chunks instead of one DDS write per point.
+///
+/// PhysiologyWaveform carries a single value, so at 500 Hz and up every point costs a
+/// DDS write and its serialization. Points pushed here go into a lock-free ring buffer.
+/// The RunLoop publishes them as one Instrument Data sample per chunkSize points, or
+/// whatever has gathered after maxLatency, whichever comes first. Subscribers reassemble
+/// the stream with WaveformAssembler.
+///
+/// Push is meant for one producer thread per waveform. It never blocks. If the loop falls
+/// behind and the buffer fills, the oldest points are dropped, which subscribers see as a
+/// gap in point indices. The publisher must outlive the loop's Run call.
+class WaveformPublisher {
+public:
+   using Clock = RunLoop::Clock;
+
+   /// Publishes one chunk, e.g. mgr->WriteInstrumentData(data). Returns the DDS Manager error code.
+   using WriteFn = std::function<int(AMM::InstrumentData&)>;
+
+   struct Options {
+      /// Points per chunk.
+      std::size_t chunkSize = 50;
+
+      /// Longest a point waits before it is published in a partial chunk.
+      Clock::duration maxLatency = std::chrono::milliseconds(100);
+
+      /// Points buffered between chunks. Rounded up to a power of two.
+      std::size_t capacity = 4096;
+   };
+
+   struct Stats {
+      std::uint64_t points;
+      std::uint64_t dropped;
+      std::uint64_t chunks;
+      std::uint64_t failures;
+   };
+
+   WaveformPublisher (RunLoop& loop, std::string name, WriteFn write, Options options);
+
+   /// Removes the publisher's wake handler and latency timer from the loop.
+   /// Destroy on the loop thread or while it is not running.
+   ~WaveformPublisher ();
+
+   WaveformPublisher (const WaveformPublisher&) = delete;
+   WaveformPublisher& operator= (const WaveformPublisher&) = delete;
+
+   /// Adds one point with its AMM timestamp in milliseconds.
+   void Push (double value, long long timestamp);
+
+   /// Publishes every buffered point now, in as many chunks as needed.
+   /// Call on the loop thread, or after the loop has stopped.
+   void Flush ();
+
+   Stats GetStats () const;
+
+private:
+   struct Point {
+      double value;
+      long long timestamp;
+      std::uint64_t index;
+   };
+
+   /// Publishes full chunks only, or everything if partial is set.
+   void Publish (bool partial);
+   void WriteChunk ();
+
+   RunLoop& m_loop;
+   WriteFn m_write;
+   Options m_options;
+   RingBuffer<Point> m_ring;
+
+   /// Used on the loop thread only.
+   WaveformChunk m_chunk;
+   AMM::InstrumentData m_data;
+
+   std::atomic<std::uint64_t> m_nextIndex;
+   std::atomic<std::uint64_t> m_dropped;
+   std::atomic<std::uint64_t> m_chunks;
+   std::atomic<std::uint64_t> m_failures;
+};
+
+/// Reassembles waveforms from chunks published by WaveformPublisher.
+///
+/// Feed it every Instrument Data sample received. Chunks for other instruments are ignored.
+/// Each publisher session of a waveform is a stream of its own, so a restarted publisher
+/// starts a new stream rather than being taken for repeats. Points are handed on in order
+/// for each stream, and losses are counted from gaps in chunk numbers and point indices
+/// after the first chunk seen, so joining a stream late is not counted as loss.
+///
+/// OnInstrumentData may be called from several listener threads; chunks are handled one at a time.
+class WaveformAssembler {
+public:
+   /// Receives each chunk's points, in order per waveform.
+   using Handler = std::function<void(const WaveformChunk& chunk)>;
+
+   struct Stats {
+      std::uint64_t chunks;
+      std::uint64_t points;
+      std::uint64_t lostChunks;
+      std::uint64_t lostPoints;
+      std::uint64_t duplicates;
+
+      /// Publisher sessions seen, over all waveforms.
+      std::uint64_t streams;
+   };
+
+   explicit WaveformAssembler (Handler handler);
+
+   void OnInstrumentData (const AMM::InstrumentData& data);
+
+   Stats GetStats () const;
+
+private:
+   struct Stream {
+      std::uint64_t nextSeq = 0;
+      std::uint64_t nextIndex = 0;
+   };
+
+   /// Waveform name and publisher session.
+   using StreamKey = std::pair<std::string, std::uint64_t>;
+
+   Handler m_handler;
+
+   mutable std::mutex m_mutex;
+   std::map<StreamKey, Stream> m_streams;
+   WaveformChunk m_chunk;
+   Stats m_stats{ 0, 0, 0, 0, 0, 0 };
+};
+
+} // namespace Module
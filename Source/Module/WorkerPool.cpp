@@ -0,0 +1,183 @@
+#include "Module/WorkerPool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace Module {
+
+namespace {
+
+/// Tasks a strand runs before going back in the queue, so other strands get a turn.
+const std::size_t StrandBatch = 8;
+
+/// Index of the pool worker running on this thread, or -1 on other threads.
+thread_local std::size_t currentWorker = static_cast<std::size_t>(-1);
+thread_local const void* currentPool = nullptr;
+
+} // namespace
+
+WorkerPool::WorkerPool (std::size_t threads)
+   : m_runnable(0), m_nextWorker(0), m_executed(0), m_steals(0) {
+   if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+   for (std::size_t i = 0; i < threads; ++i) m_workers.emplace_back(new Worker());
+   for (std::size_t i = 0; i < threads; ++i) m_threads.emplace_back([this, i]() { Run(i); });
+}
+
+WorkerPool::~WorkerPool () {
+   {
+      std::lock_guard<std::mutex> lock(m_idleMutex);
+      m_stopping = true;
+   }
+   m_idle.notify_all();
+   for (auto& thread : m_threads) thread.join();
+}
+
+WorkerPool::Strand& WorkerPool::MakeStrand (const std::string& name) {
+   std::lock_guard<std::mutex> lock(m_strandsMutex);
+   m_strands.emplace_back(new Strand(name));
+   return *m_strands.back();
+}
+
+void WorkerPool::Post (Strand& strand, Task task) {
+   bool schedule = false;
+   {
+      std::lock_guard<std::mutex> lock(strand.m_mutex);
+      strand.m_tasks.push_back(std::move(task));
+      strand.m_maxDepth = std::max(strand.m_maxDepth, strand.m_tasks.size());
+      if (!strand.m_scheduled) {
+         strand.m_scheduled = true;
+         schedule = true;
+      }
+   }
+   if (schedule) Schedule(&strand);
+}
+
+void WorkerPool::Schedule (Strand* strand) {
+   /// A pool thread queues on its own worker, where it will most likely run next.
+   /// Anything else spreads strands across the workers.
+   std::size_t target = currentPool == this
+      ? currentWorker
+      : m_nextWorker.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+   {
+      std::lock_guard<std::mutex> lock(m_workers[target]->mutex);
+      m_workers[target]->runnable.push_back(strand);
+   }
+
+   /// Taking the idle mutex orders this with a worker checking m_runnable before it sleeps,
+   /// so the notification cannot be missed.
+   {
+      std::lock_guard<std::mutex> lock(m_idleMutex);
+      m_runnable.fetch_add(1);
+   }
+   m_idle.notify_one();
+}
+
+WorkerPool::Strand* WorkerPool::Take (std::size_t self) {
+   {
+      Worker& own = *m_workers[self];
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if (!own.runnable.empty()) {
+         Strand* strand = own.runnable.front();
+         own.runnable.pop_front();
+         return strand;
+      }
+   }
+
+   for (std::size_t i = 1; i < m_workers.size(); ++i) {
+      Worker& victim = *m_workers[(self + i) % m_workers.size()];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (!victim.runnable.empty()) {
+         Strand* strand = victim.runnable.back();
+         victim.runnable.pop_back();
+         m_steals.fetch_add(1, std::memory_order_relaxed);
+         return strand;
+      }
+   }
+   return nullptr;
+}
+
+void WorkerPool::Run (std::size_t self) {
+   currentWorker = self;
+   currentPool = this;
+
+   for (;;) {
+      {
+         std::unique_lock<std::mutex> lock(m_idleMutex);
+         m_idle.wait(lock, [this]() { return m_runnable.load() > 0 || m_stopping; });
+         if (m_runnable.load() == 0 && m_stopping) return;
+      }
+
+      Strand* strand = Take(self);
+      if (strand == nullptr) {
+         /// Counted but not yet pushed, or taken by another worker first. Look again.
+         std::this_thread::yield();
+         continue;
+      }
+      m_runnable.fetch_sub(1);
+      RunStrand(strand);
+   }
+}
+
+void WorkerPool::RunStrand (Strand* strand) {
+   for (std::size_t i = 0; i < StrandBatch; ++i) {
+      Task task;
+      {
+         std::lock_guard<std::mutex> lock(strand->m_mutex);
+         if (strand->m_tasks.empty()) {
+            strand->m_scheduled = false;
+            return;
+         }
+         task = std::move(strand->m_tasks.front());
+         strand->m_tasks.pop_front();
+      }
+
+      auto start = Clock::now();
+      task();
+      auto elapsed = Clock::now() - start;
+
+      {
+         std::lock_guard<std::mutex> lock(strand->m_mutex);
+         strand->m_executed++;
+         strand->m_total += elapsed;
+         strand->m_max = std::max(strand->m_max, elapsed);
+      }
+      m_executed.fetch_add(1, std::memory_order_relaxed);
+   }
+
+   {
+      std::lock_guard<std::mutex> lock(strand->m_mutex);
+      if (strand->m_tasks.empty()) {
+         strand->m_scheduled = false;
+         return;
+      }
+   }
+
+   /// Still has work: back of this worker's queue, behind whatever else is waiting.
+   Schedule(strand);
+}
+
+WorkerPool::Stats WorkerPool::GetStats () const {
+   Stats stats;
+   stats.threads = m_threads.size();
+   stats.executed = m_executed.load(std::memory_order_relaxed);
+   stats.steals = m_steals.load(std::memory_order_relaxed);
+   stats.depth = 0;
+
+   std::lock_guard<std::mutex> lock(m_strandsMutex);
+   for (auto& strand : m_strands) {
+      std::lock_guard<std::mutex> strandLock(strand->m_mutex);
+      StrandStats s;
+      s.name = strand->m_name;
+      s.executed = strand->m_executed;
+      s.depth = strand->m_tasks.size();
+      s.maxDepth = strand->m_maxDepth;
+      s.total = strand->m_total;
+      s.max = strand->m_max;
+      stats.depth += s.depth;
+      stats.strands.push_back(s);
+   }
+   return stats;
+}
+
+} // namespace Module
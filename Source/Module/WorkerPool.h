@@ -0,0 +1,138 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Module {
+
+/// Runs subscriber callback work on a pool of threads, in order per topic.
+///
+/// FastRTPS delivers every subscriber's samples on its listener threads, so one expensive
+/// handler, like parsing the capabilities XML of a Module Configuration, holds up every other
+/// topic behind it. A pool moves that work off the listener: the callback posts a task to a
+/// strand and returns. Tasks on one strand run one at a time, in the order they were posted;
+/// different strands run in parallel. Make one strand per topic, or per key within a topic
+/// (one per Module ID, say) where only samples for the same key must stay in order.
+///
+///    Module::WorkerPool pool;
+///    auto& configStrand = pool.MakeStrand("ModuleConfiguration");
+///
+///    void OnNewModuleConfiguration (AMM::ModuleConfiguration& mc, eprosima::fastrtps::SampleInfo_t* info) {
+///       pool.Post(configStrand, [mc]() { ParseCapabilities(mc); });
+///    }
+///
+/// Each worker keeps its own queue of runnable strands and takes from it first; a worker
+/// that runs out steals from the back of another's. A strand runs at most a few tasks before
+/// going back in the queue, so a busy strand cannot keep a worker to itself.
+///
+/// Handlers run on pool threads, concurrently with one another. Module state touched by
+/// more than one strand still needs its own synchronization, or a HandoffQueue to the
+/// module's RunLoop.
+class WorkerPool {
+public:
+   using Clock = std::chrono::steady_clock;
+   using Task = std::function<void()>;
+
+   class Strand;
+
+   struct StrandStats {
+      std::string name;
+      std::uint64_t executed;
+      std::size_t depth;
+      std::size_t maxDepth;
+      Clock::duration total;
+      Clock::duration max;
+   };
+
+   struct Stats {
+      std::size_t threads;
+      std::uint64_t executed;
+      std::uint64_t steals;
+
+      /// Tasks waiting across all strands.
+      std::size_t depth;
+
+      std::vector<StrandStats> strands;
+   };
+
+   /// Starts threads workers, or one per core when threads is 0.
+   explicit WorkerPool (std::size_t threads = 0);
+
+   /// Runs every task already posted, then stops the workers.
+   ~WorkerPool ();
+
+   WorkerPool (const WorkerPool&) = delete;
+   WorkerPool& operator= (const WorkerPool&) = delete;
+
+   /// Creates a strand. The reference stays valid for the life of the pool.
+   Strand& MakeStrand (const std::string& name);
+
+   /// Queues task to run after every task posted to strand before it.
+   /// Safe to call from any thread, including pool threads.
+   void Post (Strand& strand, Task task);
+
+   Stats GetStats () const;
+
+private:
+   struct Worker {
+      std::mutex mutex;
+      std::deque<Strand*> runnable;
+   };
+
+   void Schedule (Strand* strand);
+   Strand* Take (std::size_t self);
+   void Run (std::size_t self);
+   void RunStrand (Strand* strand);
+
+   std::vector<std::unique_ptr<Worker>> m_workers;
+   std::vector<std::thread> m_threads;
+
+   mutable std::mutex m_strandsMutex;
+   std::deque<std::unique_ptr<Strand>> m_strands;
+
+   std::mutex m_idleMutex;
+   std::condition_variable m_idle;
+   std::atomic<std::size_t> m_runnable;
+   std::atomic<std::size_t> m_nextWorker;
+   bool m_stopping = false;
+
+   std::atomic<std::uint64_t> m_executed;
+   std::atomic<std::uint64_t> m_steals;
+};
+
+class WorkerPool::Strand {
+public:
+   explicit Strand (std::string name) : m_name(std::move(name)) {}
+
+   Strand (const Strand&) = delete;
+   Strand& operator= (const Strand&) = delete;
+
+private:
+   friend class WorkerPool;
+
+   std::string m_name;
+
+   std::mutex m_mutex;
+   std::deque<Task> m_tasks;
+
+   /// Set while the strand is queued on a worker or running, so it is never run by two
+   /// workers at once.
+   bool m_scheduled = false;
+
+   std::size_t m_maxDepth = 0;
+   std::uint64_t m_executed = 0;
+   Clock::duration m_total = Clock::duration::zero();
+   Clock::duration m_max = Clock::duration::zero();
+};
+
+} // namespace Module
@@ -108,6 +108,10 @@ void Tutorial_1 () {
    /// data is written, if the FastRTPS framework isn't ready to write data.
    ///
    /// 200ms is the lowest allowable delay.
+   ///
+   /// A fixed delay is the simplest option, but it adds startup latency and still loses the
+   /// write if discovery takes longer. Tutorial 7 shows Module::PublisherGate, which buffers
+   /// writes until the publisher is ready instead of sleeping.
    std::this_thread::sleep_for(std::chrono::milliseconds(200));
 
 
@@ -7,11 +7,21 @@
 /// In order to use the AMM Library, thsi header must be included.
 #include <amm_std.h>
 
+/// Blocking keep-alive loop.
+#include "Module/RunLoop.h"
+
+/// Module::Log, so OnAssessmentEvent does not write to the console on the listener thread.
+#include "Module/Logger.h"
+
 namespace T2 {
 
 /// See main body tutorial first.
 void OnAssessmentEvent (AMM::Assessment& assessment, eprosima::fastrtps::SampleInfo_t* info) {
-   std::cout << "Assessment received!" << std::endl;
+
+   /// Callbacks run on a DDS listener thread and should return quickly.
+   /// Module::Log queues the line and writes it in the background, where std::cout with
+   /// std::endl would flush the console on every sample.
+   Module::Log().Info("Assessment received!");
 }
 
 
@@ -72,16 +82,12 @@ void Tutorial_2 () {
 
    /// Keep thread alive to listen for subscribed events for this tutorial.
 
-   bool isRunning = true;
-   auto loop = [&]() {
-      for (;;) {
-         if (!isRunning) break;
-      }
-   };
-   std::thread t(loop);
+   /// The run loop sleeps until it is stopped, so waiting here costs no CPU.
+   Module::RunLoop loop;
+   std::thread t([&]() { loop.Run(); });
    std::cout << "Listening for Assessment Data... Press return to exit." << std::endl;
    std::cin.get();
-   isRunning = false;
+   loop.Stop();
    t.join();
 
    mgr->Shutdown();
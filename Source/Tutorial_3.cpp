@@ -7,6 +7,12 @@
 /// In order to use the AMM Library, thsi header must be included.
 #include <amm_std.h>
 
+/// Blocking keep-alive loop.
+#include "Module/RunLoop.h"
+
+/// Module::Log, used by Foo's subscriber callback.
+#include "Module/Logger.h"
+
 namespace T3 {
 
 /// Tutorial 3 -- Initializing <TYPE> DDS Manager and subscribing to Assessment data
@@ -20,7 +26,7 @@ void Tutorial_3 () {
       /// ATTENTION:
       /// Class methods designed for subscriber callbacks must be public.
       void OnAssessmentEvent(AMM::Assessment& assessment, eprosima::fastrtps::SampleInfo_t* info) {
-         std::cout << "Assessment received!" << std::endl;
+         Module::Log().Info("Assessment received!");
       }
 
       /// NOTE:
@@ -73,16 +79,11 @@ void Tutorial_3 () {
    /// END TUTORIAL 3
 
    /// Keep thread alive to listen for subscribed events for this tutorial.
-   bool isRunning = true;
-   auto loop = [&]() {
-      for (;;) {
-         if (!isRunning) break;
-      }
-   };
-   std::thread t(loop);
+   Module::RunLoop loop;
+   std::thread t([&]() { loop.Run(); });
    std::cout << "Listening for Assessment Data... Press return to exit." << std::endl;
    std::cin.get();
-   isRunning = false;
+   loop.Stop();
    t.join();
 
    mgr->Shutdown();
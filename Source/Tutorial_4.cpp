@@ -7,6 +7,12 @@
 /// In order to use the AMM Library, thsi header must be included.
 #include <amm_std.h>
 
+/// Blocking keep-alive loop.
+#include "Module/RunLoop.h"
+
+/// Module::Log, used by the Assessment callback on Foo.
+#include "Module/Logger.h"
+
 
 /// Tutorial 4 -- Initializing DDS Manager inside an object and subscribing to Assessment data.
 
@@ -52,7 +58,7 @@ public:
 
    /// Assessment subscription callback.
    void OnAssessmentEvent(AMM::Assessment& assessment, eprosima::fastrtps::SampleInfo_t* info) {
-      std::cout << "Assessment received!" << std::endl;
+      Module::Log().Info("Assessment received!");
    }
 
 };
@@ -70,16 +76,12 @@ void Tutorial_4 () {
    /// END TUTORIAL 4
 
    /// Keep thread alive to listen for subscribed events for tutorial purposes.
-   bool isRunning = true;
-   auto loop = [&]() {
-      for (;;) {
-         if (!isRunning) break;
-      }
-   };
-   std::thread t(loop);
+   /// Run blocks until Stop is called, without spinning.
+   Module::RunLoop loop;
+   std::thread t([&]() { loop.Run(); });
    std::cout << "Listening for Assessment Data... Press return to exit." << std::endl;
    std::cin.get();
-   isRunning = false;
+   loop.Stop();
    t.join();
 
    delete foo;
@@ -8,11 +8,17 @@
 /// In order to use the AMM Library, thsi header must be included.
 #include <amm_std.h>
 
+/// Module::Log, used by OnAssessmentEvent below.
+#include "Module/Logger.h"
+
+/// Error codes for hot-path DDS Manager calls.
+#include "Module/DdsError.h"
+
 namespace T5 {
 
 /// See main body tutorial first.
 void OnAssessmentEvent (AMM::Assessment& assessment, eprosima::fastrtps::SampleInfo_t* info) {
-   std::cout << "Assessment received!" << std::endl;
+   Module::Log().Info("Assessment received!");
 }
 
 
@@ -50,6 +56,12 @@ void Tutorial_5 () {
    /// Provide container as first argument.
    err = mgr->InitializeAssessment(errmsg);
 
+   /// Not a DDS Manager requirement.
+   /// Keep what was set up for Assessment, so a failed write below can say which step it
+   /// is missing without asking DDS Manager for a message.
+   Module::DdsSetup assessmentSetup;
+   assessmentSetup.typeInitialized = err == 0;
+
    /// Handle error.
    if (err != 0) {
       /// Output the error message using your favorite logging API.
@@ -92,6 +104,8 @@ void Tutorial_5 () {
 
       /// Output error message.
       std::cout << errmsg << std::endl;
+   } else {
+      assessmentSetup.publisherCreated = true;
    }
 
    /// NOTE:
@@ -117,10 +131,15 @@ void Tutorial_5 () {
    AMM::Assessment a;
 
    /// Send Assessment data to the Assessment writer.
-   if (mgr->WriteAssessment(errmsg, a) != 0) {
-
-      /// Output error message.
-      std::cout << errmsg << std::endl;
+   /// The errmsg overloads build a string on every call, even when it succeeds. Writes are
+   /// made many times a second, so call the plain overload and wrap its return code instead.
+   /// The setup recorded above picks the reason, and the message is only formatted if it is
+   /// asked for.
+   Module::DdsResult result(mgr->WriteAssessment(a), assessmentSetup.WriteFailure(), "WriteAssessment");
+   if (!result.Ok()) {
+
+      /// Output error message, e.g. "WriteAssessment: no publisher for this topic".
+      std::cout << result.Message() << std::endl;
    }
 
    /// Thread delay to show subscriber receiving published Assessment data.
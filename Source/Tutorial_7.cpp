@@ -1,10 +1,46 @@
 
 #include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
 #include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
 
 /// In order to use the AMM Library, this header must be included.
 #include <amm_std.h>
 
+/// Module run loop that module logic executes on.
+#include "Module/RunLoop.h"
+
+/// Hands samples from listener threads to the run loop.
+#include "Module/HandoffQueue.h"
+
+/// Lock-free module state and run state.
+#include "Module/DoubleBuffer.h"
+#include "Module/SimClock.h"
+#include "Module/SimStateMachine.h"
+#include "Module/StateFile.h"
+#include "Module/StatusTable.h"
+#include "Module/TopicFilter.h"
+#include "Module/Versioned.h"
+
+/// Latest Physiology Values, readable from the module loop.
+#include "Module/ValueCache.h"
+
+/// Figures reported by the headless entry point.
+#include "Metrics/Report.h"
+
+/// Asynchronous logging for callbacks and the module loop.
+#include "Module/Logger.h"
+
+/// Startup writes that wait for publishers to be ready.
+#include "Module/PublisherGate.h"
+
+/// Shared memory and intra-process transport profiles.
+#include "Module/Transport.h"
+
 namespace T7 {
 
 /// Tutorial 7 -- Builing an AMM compliant module
@@ -21,15 +57,19 @@ namespace T7 {
 
 
 /// Data representing this module's state.
+///
+/// The large parts are Versioned: copying a Module State, as RESET does, only copies pointers
+/// to them. Code that needs one of them beyond a short read can keep its own copy of the
+/// Versioned, and that version stays valid even after the state moves on.
 struct ModuleState {
 
    /// Module Configuration.
-   AMM::ModuleConfiguration mc;
+   Module::Versioned<AMM::ModuleConfiguration> mc;
 
    /// Status of each capability this module has.
    /// Subject to change during simulation.
    /// This module only has one capability.
-   AMM::Status fooStatus;
+   Module::Versioned<AMM::Status> fooStatus;
 
    /// ID of the current educational encounter running on the current sim.
    /// This should always mirror what educational encounter is on Module Configuration.
@@ -40,6 +80,10 @@ struct ModuleState {
    /// Number of ticks this module recieved from Sim Manager
    /// while the sim is running.
    int tickCount = 0;
+
+   /// Simulation seconds this module has advanced through while the sim is running.
+   /// Follows Tick frame numbers, so late or missing Ticks do not put it behind.
+   double simTime = 0.0;
 };
 
 /// DDSManager for this module.
@@ -55,84 +99,279 @@ AMM::OperationalDescription od;
 
 /// The current state of this module.
 /// Data that is changed as the sim progresses.
-ModuleState currentState;
+/// Kept in a Double Buffer so any thread can read it without a lock while the module
+/// loop changes it.
+Module::DoubleBuffer<ModuleState> currentState;
 
 /// The default state of this module.
-/// Data that is cached at this module's start, then loaded
+/// Data that is set up at this module's start, then loaded
 /// as the currentState when Sim Control RESET is called.
 ModuleState defaultState;
 
-/// Control flag for running this module with the active sim.
-bool isSimRunning = false;
+/// Whether this module is running with the active sim.
+/// Transitions are atomic, so they are applied as soon as Simulation Control or this module's
+/// Module Configuration arrives on the listener thread, and the next Tick the module handles
+/// already sees them. Applying every transition there keeps them in arrival order.
+Module::SimStateMachine simState;
 
-void OnNewSimulationControl (AMM::SimulationControl& simControl, eprosima::fastrtps::SampleInfo_t* info) {
+/// Where this module keeps its save state between runs.
+const std::string saveStatePath = "ExampleModule_T7.state";
+
+/// Version of what SaveModuleState writes. Bump it whenever that changes,
+/// so older save files are ignored instead of misread.
+const std::uint32_t saveStateFormat = 3;
+
+/// Whether to start from the save file. Set AMM_RESTORE_STATE=1 to restore; otherwise every
+/// run starts from the XML config files.
+bool RestoreRequested () {
+   const char* value = std::getenv("AMM_RESTORE_STATE");
+   return value != nullptr && std::string(value) != "" && std::string(value) != "0";
+}
+
+/// Writes the Operational Description, the configuration this run started from and the given
+/// Module State to the save file.
+int SaveModuleState (const ModuleState& state, std::string& errmsg) {
+   Module::StateWriter writer(saveStateFormat);
+   writer
+   .Write(od)
+   .Write(defaultState.mc->capabilities_configuration())
+   .Write(*state.mc)
+   .Write(*state.fooStatus)
+   .Write(state.educationalEncoutner)
+   .Write(static_cast<std::int32_t>(state.tickCount))
+   .Write(state.simTime);
+   return writer.Save(saveStatePath, errmsg);
+}
+
+/// Loads the save file into state, which holds this run's startup defaults.
+/// The save is only used if it was made from the same Operational Description and startup
+/// configuration as this run, so edits to the XML config files are never silently ignored.
+/// The module keeps the ID it was given this run. Nothing is changed unless the whole file
+/// reads back correctly and matches.
+int LoadModuleState (ModuleState& state, std::string& errmsg) {
+   Module::StateReader reader;
+   if (reader.Load(saveStatePath, saveStateFormat, errmsg) != 0) return 1;
+
+   AMM::OperationalDescription savedOd;
+   std::string startupConfiguration;
+   AMM::ModuleConfiguration mc;
+   AMM::Status fooStatus;
+   AMM::UUID educationalEncounter;
+   std::int32_t tickCount = 0;
+   double simTime = 0.0;
+
+   if (reader.Read(savedOd, errmsg) != 0) return 1;
+   if (reader.Read(startupConfiguration, errmsg) != 0) return 1;
+   if (reader.Read(mc, errmsg) != 0) return 1;
+   if (reader.Read(fooStatus, errmsg) != 0) return 1;
+   if (reader.Read(educationalEncounter, errmsg) != 0) return 1;
+   if (reader.Read(tickCount, errmsg) != 0) return 1;
+   if (reader.Read(simTime, errmsg) != 0) return 1;
+
+   if (savedOd.name() != od.name() ||
+       savedOd.module_version() != od.module_version() ||
+       savedOd.capabilities_schema() != od.capabilities_schema()) {
+      errmsg = saveStatePath + " was saved by a different module version or capabilities schema";
+      return 1;
+   }
+   if (startupConfiguration != state.mc->capabilities_configuration()) {
+      errmsg = saveStatePath + " was saved from a different capabilities configuration";
+      return 1;
+   }
+
+   mc.module_id(moduleId);
+   fooStatus.module_id(moduleId);
+   state.mc = Module::Versioned<AMM::ModuleConfiguration>(std::move(mc));
+   state.fooStatus = Module::Versioned<AMM::Status>(std::move(fooStatus));
+   state.educationalEncoutner = educationalEncounter;
+   state.tickCount = tickCount;
+   state.simTime = simTime;
+   return 0;
+}
+
+/// A Simulation Control sample together with the transition it caused.
+struct ControlRequest {
+   AMM::SimulationControl simControl;
+   Module::SimStateMachine::Snapshot transition;
+};
+
+/// The module's execution loop.
+/// Subscriber callbacks run on FastRTPS listener threads. They hand a copy of each sample
+/// to this loop through a lock-free Handoff Queue and return, so a slow update never holds up
+/// delivery of other topics, and module state is only ever touched from the loop's thread.
+Module::RunLoop loop;
+
+/// Gate for Status writes while the publisher starts up. Created in RunModule, and only set
+/// while RunModule is running.
+Module::PublisherGate* statusGate = nullptr;
+
+/// The Status of each capability as last published.
+/// Every Status change goes through this table. Changes made within 100 ms of each other are
+/// published as one write with the latest value, so a flapping capability does not flood the
+/// network, and the final state is always published.
+Module::StatusTable statusTable(loop, [](AMM::Status& status) {
+   if (statusGate == nullptr) return 1;
+   return statusGate->Write([status]() mutable { return mgr->WriteStatus(status); });
+}, Module::StatusTable::Options{});
+
+void HandleSimulationControl (ControlRequest& request) {
 
    /// AMM modules are required to act accordingly to the data subscribed to in this receiver.
+   /// The run state itself already changed in OnNewSimulationControl. What is left here are
+   /// the side effects of each transition.
 
-   switch (simControl.type()) {
+   switch (request.simControl.type()) {
 
    case AMM::ControlType::RUN :
 
-      std::cout << "Sim RUN." << std::endl;
-
-      /// Set this flag true and allow regular updates to occur.
-      isSimRunning = true;
+      /// Regular updates are now allowed to occur.
+      Module::Log().Info("Sim RUN.");
       break;
 
    case AMM::ControlType::HALT :
 
-      std::cout << "Sim HALT." << std::endl;
-
-      /// Set this flag false and not allow updates that involve patient
-      /// action or movement other than render status for current or initial sim state.
-      isSimRunning = false;
+      /// No updates that involve patient action or movement other than render status
+      /// for current or initial sim state.
+      Module::Log().Info("Sim HALT.");
       break;
 
    case AMM::ControlType::RESET :
 
-      std::cout << "Sim RESET." << std::endl;
+      Module::Log().Info("Sim RESET.");
 
       /// On RESET, modules also become HALTED and reset their state to their startup defaults.
-      isSimRunning = false;
-      currentState = defaultState;
+      /// Since the large parts of Module State are shared, this copies no configuration data.
+      currentState.Store(defaultState);
+      statusTable.Set(*defaultState.fooStatus);
       break;
 
-   case AMM::ControlType::SAVE :
+   case AMM::ControlType::SAVE : {
 
-      std::cout << "Sim set to SAVE.n" << std::endl;
+      Module::Log().Info("Sim set to SAVE.");
 
       /// On SAVE, modules publish their current Module Configuration so the Module Monager
       /// on the network may cache their data as a save state for future use.
-      mgr->WriteModuleConfiguration(currentState.mc);
+      ModuleState state = *currentState.Read();
+      AMM::ModuleConfiguration mc = *state.mc;
+      mgr->WriteModuleConfiguration(mc);
+
+      /// Not a module requirement.
+      /// This module also keeps its complete state locally, so it can start from it next time.
+      std::string errmsg;
+      if (SaveModuleState(state, errmsg) != 0) {
+         Module::Log().Error(errmsg);
+      }
       break;
    }
+   }
+
+   simState.MarkEffect(request.transition.generation);
 }
 
-void OnNewModuleConfiguration (AMM::ModuleConfiguration& modConfig, eprosima::fastrtps::SampleInfo_t* info) {
+/// Simulation Control must never be lost, so the listener waits for room if the module falls behind.
+/// It is also the module's most urgent input, so it drains ahead of every other queue, and in
+/// between the samples they handle.
+Module::HandoffQueue<ControlRequest> simControlQueue(
+   loop, 64, Module::OverflowPolicy::Block, &HandleSimulationControl, Module::RunLoop::Priority::Control
+);
+
+void OnNewSimulationControl (AMM::SimulationControl& simControl, eprosima::fastrtps::SampleInfo_t* info) {
+   ControlRequest request;
+   request.simControl = simControl;
+   request.transition = simState.Apply(simControl.type());
+   simControlQueue.Push(request);
+}
+
+/// A Module Configuration sample together with the transition it caused.
+struct ConfigRequest {
+   AMM::ModuleConfiguration modConfig;
+   Module::SimStateMachine::Snapshot transition;
+};
+
+void HandleModuleConfiguration (ConfigRequest& request) {
+
+   /// Only Module Configuration for this module gets this far. See modConfigFilter.
+   /// The halt it causes was already applied in the filter.
+   Module::Log().Info("Module config received. Changing this module's config.");
 
-   std::cout << "Module config received." << std::endl;
+   /// Make the new version once. Modify applies its change to both copies of the state,
+   /// and both should share this one version.
+   Module::Versioned<AMM::ModuleConfiguration> mc(std::move(request.modConfig));
+   currentState.Modify([&mc](ModuleState& state) { state.mc = mc; });
+   simState.MarkEffect(request.transition.generation);
 
-   /// Only acknowledge this event if the incoming ID matches this module.
-   if (moduleId.id() != modConfig.module_id().id()){
-      std::cout << "Module config not for this module." << std::endl;
-      return;
+   /// Acknowledge the new configuration by publishing this capability's Status again.
+   /// The acknowledgement should not wait for the coalescing window, so flush it now.
+   /// The table updates the timestamp, which MUST change whenever a Status is published.
+   statusTable.Republish(currentState.Read()->fooStatus->capability());
+   statusTable.Flush();
+}
+
+Module::HandoffQueue<ConfigRequest> modConfigQueue(
+   loop, 64, Module::OverflowPolicy::Block, &HandleModuleConfiguration
+);
+
+/// Only acknowledge Module Configuration if the incoming ID matches this module.
+/// Every module on the network receives every module's configuration, so the rest is dropped
+/// right in the callback, before it is copied into the queue or wakes the module loop.
+///
+/// According to module behaviour requirements, all modules must enter a halted state when new
+/// Module Configuration data is published. Like RUN and HALT, the halt is applied here on the
+/// listener thread, so a RUN that arrives after it is never undone by it.
+Module::TopicFilter<AMM::ModuleConfiguration> modConfigFilter(
+   Module::ForModule<AMM::ModuleConfiguration>(&moduleId),
+   [](AMM::ModuleConfiguration& modConfig) {
+      ConfigRequest request;
+      request.modConfig = modConfig;
+      request.transition = simState.Apply(Module::SimEvent::ConfigChange);
+      modConfigQueue.Push(request);
    }
+);
 
-   std::cout << "Changing this module's config." << std::endl;
+void OnNewModuleConfiguration (AMM::ModuleConfiguration& modConfig, eprosima::fastrtps::SampleInfo_t* info) {
+   modConfigFilter.OnSample(modConfig);
+}
 
-   /// Enter a halted state.
-   /// According to module behaviour requirements, all modules must enter a halted state
-   /// when new Module Configuration data is published.
-   isSimRunning = false;
+/// Not a module requirement.
+/// Latest value of every Physiology Value received. The subscriber callback stores each sample
+/// straight into the cache, and the module loop reads what it needs on each Tick.
+Module::ValueCache physiology;
 
-   currentState.mc = modConfig;
+/// Resolved once, so reading it on each Tick is a plain array lookup.
+const Module::ValueCache::Id heartRateId = physiology.Intern("Cardiovascular_HeartRate");
+
+void OnNewPhysiologyValue (AMM::PhysiologyValue& value, eprosima::fastrtps::SampleInfo_t* info) {
+   physiology.Update(value);
+}
+
+/// Not a module requirement.
+/// Keeps simulation time in step with Sim Manager's Tick frame numbers. A Tick that arrives
+/// twice is ignored, and when Ticks go missing, whether lost on the network or dropped from
+/// the queue because the module fell behind, the missed steps are run on the next one.
+/// Sim Manager's default rate is 50 Hz.
+Module::SimClock::Options SimClockOptions () {
+   Module::SimClock::Options options;
+   options.period = std::chrono::milliseconds(20);
+   options.catchUp = Module::SimClock::CatchUp::RunMissed;
+   return options;
 }
 
-/// Receiver for Tick data that advances the simulation one frame forward in time.
+Module::SimClock simClock(SimClockOptions());
+
+/// A Tick and when it arrived, so the clock sees network timing rather than queue timing.
+struct TickSample {
+   AMM::Tick tick;
+   Module::SimClock::Clock::time_point arrived;
+};
+
+/// Advances the simulation one frame forward in time.
 /// Also refered to as the AMM Update Loop.
-void Update (AMM::Tick& tick, eprosima::fastrtps::SampleInfo_t* info) {
+void HandleTick (TickSample& sample) {
+
+   Module::Log().Info("Tick received!");
 
-   std::cout << "Tick received!" << std::endl;
+   auto advance = simClock.OnTick(sample.tick.frame(), sample.tick.time_dilation(), sample.arrived);
+   if (advance.steps == 0) return;
 
    /// Update this module according to what it should be doing.
 
@@ -140,17 +379,87 @@ void Update (AMM::Tick& tick, eprosima::fastrtps::SampleInfo_t* info) {
    /// This is up to the user's discretion on what should update and what should not.
    /// AMM spec deictates that no manikin activity or movement should update while halted,
    /// but environmental effects may still be rendered to maintain state of the current scenario.
-   if (!isSimRunning) return;
+   auto sim = simState.Current();
+   simState.MarkEffect(sim.generation);
+   if (!sim.running) return;
 
    /// Not a module requirement.
    /// Shows that the module is updating something in this example when a tick is received.
-   currentState.tickCount++;
-   std::cout << "Tick Count: " << currentState.tickCount << std::endl;
+   /// A module with real per-step logic would run it advance.steps times, each covering
+   /// advance.stepSeconds of simulation time.
+   currentState.Modify([&advance](ModuleState& state) {
+      state.tickCount += static_cast<int>(advance.steps);
+      state.simTime += advance.seconds;
+   });
+
+   std::string message = "Tick Count: " + std::to_string(currentState.Read()->tickCount);
+
+   /// Not a module requirement.
+   /// Reads the latest heart rate the physiology engine published, if any.
+   Module::ValueCache::Value heartRate;
+   if (physiology.Get(heartRateId, heartRate)) message += " Heart Rate: " + std::to_string(heartRate.value);
+
+   Module::Log().Info(message);
+}
+
+/// Only recent Ticks matter, so the oldest queued Tick is dropped if the module falls behind.
+Module::HandoffQueue<TickSample> tickQueue(
+   loop, 1024, Module::OverflowPolicy::DropOldest, &HandleTick
+);
+
+/// Receiver for Tick data. Queues one update on the module loop.
+void Update (AMM::Tick& tick, eprosima::fastrtps::SampleInfo_t* info) {
+   tickQueue.Push(TickSample{ tick, Module::SimClock::Clock::now() });
+}
+
+
+/// Adds this module's runtime figures to a report. Called by the headless entry point.
+void ReportStats (Metrics::Report& report) {
+   auto ticks = tickQueue.GetStats();
+   report
+   .Add("ticks_received", ticks.pushed)
+   .Add("ticks_handled", ticks.delivered)
+   .Add("ticks_dropped", ticks.dropped)
+   .Add("tick_queue_max_depth", static_cast<std::uint64_t>(ticks.maxDepth))
+   .Add("tick_handoff_mean_us", ticks.delivered
+      ? std::chrono::duration<double, std::micro>(ticks.latencyTotal).count() / ticks.delivered : 0.0)
+   .Add("tick_handoff_max_us", std::chrono::duration<double, std::micro>(ticks.latencyMax).count())
+   .Add("tick_count", currentState.Read()->tickCount)
+   .Add("sim_time_s", currentState.Read()->simTime);
+
+   auto clock = simClock.GetStats();
+   report
+   .Add("tick_last_frame", clock.lastFrame)
+   .Add("tick_duplicates", clock.duplicates)
+   .Add("tick_gaps", clock.gaps)
+   .Add("tick_frames_missed", clock.missedFrames)
+   .Add("tick_steps_skipped", clock.skippedSteps)
+   .AddLatency("tick_interval", clock.interval)
+   .AddLatency("tick_jitter", clock.jitter);
+
+   auto modConfigs = modConfigFilter.GetStats();
+   report
+   .Add("mc_received", modConfigs.received)
+   .Add("mc_delivered", modConfigs.delivered);
+
+   auto status = statusTable.GetStats();
+   report
+   .Add("status_changes", status.changes)
+   .Add("status_coalesced", status.coalesced)
+   .Add("status_writes", status.writes);
+
+   auto halt = simState.GetLatency(Module::SimEvent::Halt);
+   report
+   .Add("halt_count", halt.count)
+   .Add("halt_effect_max_us", std::chrono::duration<double, std::micro>(halt.max).count());
 }
 
 
 /// START TUTORIAL HERE.
-void Tutorial_7 () {
+///
+/// Runs this module with the DDS configuration file configPath until waitForExit returns.
+/// Tutorial_7, at the bottom of this file, waits for the return key.
+void RunModule (const std::string& configPath, const std::function<void()>& waitForExit) {
 
    /// Timestamp generation.
    using namespace std::chrono;
@@ -179,7 +488,8 @@ void Tutorial_7 () {
 
    /// DDS MANAGER
    /// This is basically what makes something an AMM module.
-   mgr = new AMM::DDSManager<void>("Config/Config.xml");
+   /// The configuration file picks a transport profile for this deployment.
+   mgr = new AMM::DDSManager<void>(configPath);
 
    /// Once a module has a live DDS Manager, it now needs to fill out some description data
    /// about itself. Two topic types that are required at the module's inception are
@@ -225,12 +535,15 @@ void Tutorial_7 () {
 
    /// Initializing Module Configuration fields.
    /// Note that the Module Configuration representing this module is in the Module State struct.
-   currentState.mc.name("Example Module - T7");
-   currentState.mc.module_id(moduleId);
-   currentState.mc.timestamp(timestamp);
-   currentState.mc.capabilities_configuration(
-      AMM::Utility::read_file_to_string("Config/CapabilitiesConfiguration.xml")
-   );
+   /// Startup values are filled in on the default state, which becomes the current state below.
+   defaultState.mc = defaultState.mc.With([&](AMM::ModuleConfiguration& mc) {
+      mc.name("Example Module - T7");
+      mc.module_id(moduleId);
+      mc.timestamp(timestamp);
+      mc.capabilities_configuration(
+         AMM::Utility::read_file_to_string("Config/CapabilitiesConfiguration.xml")
+      );
+   });
 
 
    /// SIMULATION CONTROL
@@ -254,12 +567,22 @@ void Tutorial_7 () {
    mgr->CreateStatusPublisher();
 
    /// Initializing Status fields.
-   currentState.fooStatus.module_id(moduleId);
-   currentState.fooStatus.module_name("Example Module");
-   currentState.fooStatus.capability("Foo");
-   currentState.fooStatus.timestamp(timestamp);
-   currentState.fooStatus.value(AMM::StatusValue::OPERATIONAL);
-   currentState.fooStatus.message("Ready");
+   defaultState.fooStatus = defaultState.fooStatus.With([&](AMM::Status& status) {
+      status.module_id(moduleId);
+      status.module_name("Example Module");
+      status.capability("Foo");
+      status.timestamp(timestamp);
+      status.value(AMM::StatusValue::OPERATIONAL);
+      status.message("Ready");
+   });
+
+
+   /// Not a module requirement.
+   /// The module's log also goes out as AMM Log, so its messages can be seen alongside
+   /// those of every other module on the network.
+   mgr->InitializeLog();
+   mgr->CreateLogPublisher();
+   Module::Log().PublishTo(mgr, moduleId);
 
 
    /// Another recommened topic type to subscribe to is Tick.
@@ -271,42 +594,79 @@ void Tutorial_7 () {
    mgr->InitializeTick();
    mgr->CreateTickSubscriber(&Update);
 
+   /// Not a module requirement.
+   /// Modules that react to the patient's physiology subscribe to Physiology Value.
+   mgr->InitializePhysiologyValue();
+   mgr->CreatePhysiologyValueSubscriber(&OnNewPhysiologyValue);
+
+
+   /// Once the module is initialized with its defaults, start the current state
+   /// from them. The default state stays cached so when a RESET is called, all the
+   /// properites on the module can be reverted.
+   ModuleState startState = defaultState;
 
-   /// Once the module is initialized with its defaults, cache the current
-   /// state so when a RESET is called, all the properites on the module can
-   /// be reverted.
-   defaultState = currentState;
+   /// SAVE STATE
+   /// Not a module requirement.
+   /// When asked to, start from the state this module saved on an earlier SAVE instead.
+   /// Only the current state is restored. RESET still returns to the startup defaults above.
+   if (RestoreRequested()) {
+      std::string errmsg;
+      if (LoadModuleState(startState, errmsg) == 0) {
+         Module::Log().Info("Restored module state from " + saveStatePath);
+      } else {
+         Module::Log().Warning("Not restoring module state: " + errmsg);
+      }
+   }
+   currentState.Store(startState);
 
    /// NOTE:
    /// Operational Description is not being cached, because it should remain static and unchanged
    /// after initialization for the remainder of the module's lifespan.
 
-   /// Need a pause to allow publishers to finish initializing.
-   std::this_thread::sleep_for(std::chrono::milliseconds(250));
+   /// Publishers need time to match with readers before anything written to them is delivered.
+   /// Rather than pausing for a fixed time, each startup write goes through a Publisher Gate.
+   /// The gate sends right away and keeps re-sending with a growing interval until the publisher
+   /// is matched or the deadline passes, so the first write is neither delayed nor lost.
+   /// Repeating these three topics is harmless since each sample is this module's latest value.
+   Module::PublisherGate::Options gateOptions;
+   gateOptions.resendInterval = std::chrono::milliseconds(25);
+
+   Module::PublisherGate odGate(loop, gateOptions);
+   Module::PublisherGate mcGate(loop, gateOptions);
+   Module::PublisherGate statusPublisherGate(loop, gateOptions);
+   statusGate = &statusPublisherGate;
 
    /// Write out Operational Description, Module Configuration, and the Status for each capability.
-   mgr->WriteOperationalDescription(od);
-   mgr->WriteModuleConfiguration(currentState.mc);
-   mgr->WriteStatus(currentState.fooStatus);
+   odGate.Write([]() { return mgr->WriteOperationalDescription(od); });
+   mcGate.Write([mc = *startState.mc]() mutable { return mgr->WriteModuleConfiguration(mc); });
+   statusTable.Set(*startState.fooStatus);
+   statusTable.Flush();
 
 
 
-   bool isRunning = true;
-   auto loop = [&]() {
-      /// Module's main execution loop.
-      /// Non-AMM specific updating logic is done here according to user specification.
-      /// Loop ends when module sets the flag. Then DDS Manager shuts down and the program exits.
-      /// Logic that alters AMM data should NOT go here. Use a Tick subscriber as the update loop.
-      for (;;) {
-         if (!isRunning) break;
-      }
-   };
-   std::thread t(loop);
-   std::cout << "Listening for data... Press return to exit." << std::endl;
-   std::cin.get();
-   isRunning = false;
+   /// Module's main execution loop.
+   /// Non-AMM specific updating logic is done here according to user specification, and
+   /// the callbacks above queue their work onto it as well. The loop thread sleeps until
+   /// work arrives, a timer comes due, or the loop is stopped.
+   /// Loop ends when module stops it. Then DDS Manager shuts down and the program exits.
+   std::thread t([]() { loop.Run(); });
+   waitForExit();
+   loop.Stop();
    t.join();
 
+   /// Publish any Status change still waiting for its window, then detach the table from the
+   /// gate, which goes out of scope when RunModule returns. The loop has stopped, so a
+   /// failed write will not be retried.
+   if (statusTable.Flush() != 0) {
+      Module::Log().Warning("Could not publish the final Status.");
+   }
+   statusGate = nullptr;
+
+   /// Write out anything still waiting in the log, then stop publishing it before the
+   /// DDS Manager goes away.
+   Module::Log().Flush();
+   Module::Log().PublishTo(nullptr, moduleId);
+
 
    mgr->Shutdown();
 
@@ -323,6 +683,15 @@ void Tutorial_7 () {
 
    /// END TUTORIAL 7
 
-} // Tutorial_7
+} // RunModule
+
+void Tutorial_7 () {
+   /// The AMM_TRANSPORT environment variable picks a transport profile:
+   /// udp, shm (modules on the same host) or intra (modules in the same process).
+   RunModule(Module::TransportConfigFromEnvironment(), []() {
+      std::cout << "Listening for data... Press return to exit." << std::endl;
+      std::cin.get();
+   });
+}
 
 } // namespace T7